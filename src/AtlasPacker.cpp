@@ -0,0 +1,90 @@
+#include "AtlasPacker.hpp"
+#include <algorithm>
+
+CShelfPacker::CShelfPacker(int pageWidth, int pageHeight, size_t maxPages)
+    : m_pageWidth(pageWidth), m_pageHeight(pageHeight), m_maxPages(maxPages) {}
+
+std::optional<SAtlasSlot> CShelfPacker::allocateInPage(size_t pageIndex,
+                                                       int width, int height) {
+  auto &page = m_pages[pageIndex];
+
+  // Best fit: the shelf wasting the least height
+  SShelf *best = nullptr;
+  for (auto &shelf : page.shelves) {
+    if (shelf.height < height || m_pageWidth - shelf.cursor < width)
+      continue;
+    if (!best || shelf.height < best->height)
+      best = &shelf;
+  }
+
+  // Open a new shelf below the last one
+  if (!best) {
+    const int TOP = page.shelves.empty()
+                        ? 0
+                        : page.shelves.back().y + page.shelves.back().height;
+    if (m_pageHeight - TOP < height)
+      return std::nullopt;
+    page.shelves.push_back({TOP, height, 0});
+    best = &page.shelves.back();
+  }
+
+  SAtlasSlot slot = {pageIndex, best->cursor, best->y, width, height};
+  best->cursor += width;
+  page.usedArea += (long)width * height;
+  return slot;
+}
+
+std::optional<SAtlasSlot> CShelfPacker::allocate(int width, int height) {
+  if (width <= 0 || height <= 0 || width > m_pageWidth ||
+      height > m_pageHeight)
+    return std::nullopt;
+
+  for (size_t i = 0; i < m_pages.size(); ++i) {
+    if (auto slot = allocateInPage(i, width, height))
+      return slot;
+  }
+
+  if (m_pages.size() >= m_maxPages)
+    return std::nullopt;
+
+  m_pages.emplace_back();
+  return allocateInPage(m_pages.size() - 1, width, height);
+}
+
+void CShelfPacker::release(const SAtlasSlot &slot) {
+  if (slot.page >= m_pages.size())
+    return;
+
+  auto &page = m_pages[slot.page];
+  page.usedArea -= (long)slot.width * slot.height;
+
+  auto shelf = std::ranges::find_if(page.shelves, [&](const SShelf &shelf) {
+    return shelf.y == slot.y;
+  });
+  if (shelf == page.shelves.end())
+    return;
+
+  // Only the end of a shelf can be handed out again
+  if (shelf->cursor == slot.x + slot.width)
+    shelf->cursor = slot.x;
+
+  // Drop empty shelves from the bottom so their height can be reused
+  while (!page.shelves.empty() && page.shelves.back().cursor == 0)
+    page.shelves.pop_back();
+}
+
+void CShelfPacker::reset() { m_pages.clear(); }
+
+double CShelfPacker::occupancy(size_t page) const {
+  if (page >= m_pages.size() || m_pageWidth <= 0 || m_pageHeight <= 0)
+    return 0.0;
+  return (double)m_pages[page].usedArea /
+         ((double)m_pageWidth * m_pageHeight);
+}
+
+long CShelfPacker::freeArea() const {
+  long used = 0;
+  for (const auto &page : m_pages)
+    used += page.usedArea;
+  return (long)m_maxPages * m_pageWidth * m_pageHeight - used;
+}
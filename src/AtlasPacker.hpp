@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+// Where a thumbnail lives inside the atlas
+struct SAtlasSlot {
+  size_t page = 0;
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+};
+
+// Shelf packer for thumbnail atlas pages. Rectangles are placed left to right
+// on horizontal shelves, a new shelf is opened below when none fits. Space
+// freed in the middle of a shelf is only reclaimed by reset() and packing
+// again, see CHyprView::repackAtlas().
+class CShelfPacker {
+public:
+  CShelfPacker(int pageWidth, int pageHeight, size_t maxPages);
+
+  std::optional<SAtlasSlot> allocate(int width, int height);
+  void release(const SAtlasSlot &slot);
+  void reset();
+
+  // Pages that had at least one allocation since the last reset
+  size_t pageCount() const { return m_pages.size(); }
+  // Share of a page covered by live allocations
+  double occupancy(size_t page) const;
+  // Unallocated area over all pages, including ones not opened yet
+  long freeArea() const;
+
+private:
+  struct SShelf {
+    int y = 0;
+    int height = 0;
+    int cursor = 0; // Next free x
+  };
+
+  struct SPage {
+    std::vector<SShelf> shelves;
+    long usedArea = 0;
+  };
+
+  std::optional<SAtlasSlot> allocateInPage(size_t page, int width,
+                                           int height);
+
+  int m_pageWidth;
+  int m_pageHeight;
+  size_t m_maxPages;
+  std::vector<SPage> m_pages;
+};
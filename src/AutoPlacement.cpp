@@ -0,0 +1,243 @@
+#include "PlacementAlgorithms.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+const std::vector<PlacementAlgorithm> &placementAlgorithms() {
+  static const std::vector<PlacementAlgorithm> algorithms = {
+      {"grid", gridPlacement},         {"spiral", spiralPlacement},
+      {"flow", flowPlacement},         {"adaptive", adaptivePlacement},
+      {"wide", widePlacement},         {"scale", scalePlacement},
+  };
+  return algorithms;
+}
+
+PlacementFunction findPlacementAlgorithm(const std::string &name) {
+  for (const auto &algorithm : placementAlgorithms()) {
+    if (name == algorithm.name)
+      return algorithm.function;
+  }
+  return nullptr;
+}
+
+double scorePlacement(const std::vector<WindowInfo> &windows,
+                      const ScreenInfo &screen, const PlacementResult &result,
+                      double *utilization, double *minScale) {
+  const double screenArea = screen.width * screen.height;
+  if (windows.empty() || result.tiles.size() != windows.size() ||
+      screenArea <= 0.0) {
+    if (utilization)
+      *utilization = 0.0;
+    if (minScale)
+      *minScale = 0.0;
+    return 0.0;
+  }
+
+  double coveredArea = 0.0;
+  double smallestScale = INFINITY;
+
+  for (size_t i = 0; i < windows.size(); ++i) {
+    const auto &tile = result.tiles[i];
+    const auto &window = windows[i];
+
+    if (tile.width <= 0.0 || tile.height <= 0.0 || window.width <= 0.0 ||
+        window.height <= 0.0) {
+      smallestScale = 0.0;
+      continue;
+    }
+
+    // Windows are drawn aspect-fitted inside their tile (see fullRender)
+    const double scale =
+        std::min(tile.width / window.width, tile.height / window.height);
+    smallestScale = std::min(smallestScale, scale);
+
+    const double fittedWidth = window.width * scale;
+    const double fittedHeight = window.height * scale;
+    const double x = tile.x + (tile.width - fittedWidth) / 2.0;
+    const double y = tile.y + (tile.height - fittedHeight) / 2.0;
+
+    // Only count the part that is actually on screen
+    const double visibleWidth =
+        std::min(x + fittedWidth, screen.offsetX + screen.width) -
+        std::max(x, screen.offsetX);
+    const double visibleHeight =
+        std::min(y + fittedHeight, screen.offsetY + screen.height) -
+        std::max(y, screen.offsetY);
+    if (visibleWidth > 0.0 && visibleHeight > 0.0)
+      coveredArea += visibleWidth * visibleHeight;
+  }
+
+  const double util = std::min(1.0, coveredArea / screenArea);
+  if (utilization)
+    *utilization = util;
+  if (minScale)
+    *minScale = smallestScale;
+
+  // Favour layouts that fill the screen without shrinking any single window
+  // into an unreadable tile
+  return 0.5 * util + 0.5 * std::min(1.0, smallestScale);
+}
+
+namespace {
+
+// Small persistent pool so auto placement does not spawn threads on every open
+class CPlacementWorkerPool {
+public:
+  explicit CPlacementWorkerPool(size_t threadCount) {
+    for (size_t i = 0; i < threadCount; ++i)
+      m_workers.emplace_back([this] { run(); });
+  }
+
+  ~CPlacementWorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+    }
+    m_cv.notify_all();
+    for (auto &worker : m_workers)
+      worker.join();
+  }
+
+  void submit(std::function<void()> job) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_jobs.push_back(std::move(job));
+    }
+    m_cv.notify_one();
+  }
+
+private:
+  void run() {
+    while (true) {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+        if (m_stopping)
+          return;
+        job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+      }
+      job();
+    }
+  }
+
+  std::vector<std::thread> m_workers;
+  std::deque<std::function<void()>> m_jobs;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stopping = false;
+};
+
+CPlacementWorkerPool &workerPool() {
+  static CPlacementWorkerPool pool(std::clamp<size_t>(
+      std::thread::hardware_concurrency(), 1, 4));
+  return pool;
+}
+
+// Shared between the caller and the workers - workers that miss the budget
+// still write here safely after the caller has moved on
+struct SAutoPlacementState {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::optional<PlacementResult>> results;
+  std::vector<double> elapsedMs;
+  size_t finished = 0;
+};
+
+} // namespace
+
+PlacementResult autoPlacement(const std::vector<WindowInfo> &windows,
+                              const ScreenInfo &screen, double budgetMs,
+                              std::vector<PlacementScore> *scores) {
+  const auto &algorithms = placementAlgorithms();
+
+  auto state = std::make_shared<SAutoPlacementState>();
+  state->results.resize(algorithms.size());
+  state->elapsedMs.resize(algorithms.size(), 0.0);
+
+  for (size_t i = 0; i < algorithms.size(); ++i) {
+    workerPool().submit([state, i, windows, screen,
+                         function = algorithms[i].function] {
+      const auto start = std::chrono::steady_clock::now();
+      PlacementResult result = function(windows, screen);
+      const double elapsed = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->results[i] = std::move(result);
+      state->elapsedMs[i] = elapsed;
+      state->finished++;
+      state->cv.notify_all();
+    });
+  }
+
+  // Wait for all candidates or until the latency budget is spent
+  std::vector<std::optional<PlacementResult>> results;
+  std::vector<double> elapsedMs;
+  {
+    const auto deadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration<double, std::milli>(std::max(0.0, budgetMs));
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait_until(lock, deadline, [&] {
+      return state->finished == algorithms.size();
+    });
+    results = state->results;
+    elapsedMs = state->elapsedMs;
+  }
+
+  if (scores)
+    scores->clear();
+
+  int best = -1;
+  double bestScore = -1.0;
+  for (size_t i = 0; i < algorithms.size(); ++i) {
+    PlacementScore score = {algorithms[i].name, 0.0, 0.0, 0.0, elapsedMs[i],
+                            results[i].has_value()};
+
+    if (results[i]) {
+      score.score = scorePlacement(windows, screen, *results[i],
+                                   &score.utilization, &score.minScale);
+      if (score.score > bestScore) {
+        bestScore = score.score;
+        best = (int)i;
+      }
+    }
+
+    if (scores)
+      scores->push_back(score);
+  }
+
+  // Nothing finished in time - grid is cheap enough to run inline
+  if (best < 0)
+    return gridPlacement(windows, screen);
+
+  return std::move(*results[best]);
+}
+
+PlacementResult runPlacement(const std::string &name,
+                             const std::vector<WindowInfo> &windows,
+                             const ScreenInfo &screen, double autoBudgetMs,
+                             std::vector<PlacementScore> *scores) {
+  if (name == "auto")
+    return autoPlacement(windows, screen, autoBudgetMs, scores);
+
+  if (scores)
+    scores->clear();
+
+  if (auto function = findPlacementAlgorithm(name))
+    return function(windows, screen);
+
+  // Default to grid placement
+  return gridPlacement(windows, screen);
+}
@@ -0,0 +1,89 @@
+#include "ConfigSnapshot.hpp"
+#include "globals.hpp"
+#include <algorithm>
+#include <hyprland/src/debug/Log.hpp>
+
+static SP<const SHyprViewConfig> g_hyprViewConfig;
+
+static eIndicatorPosition parseIndicatorPosition(const std::string &str) {
+  if (str == "top-left")
+    return INDICATOR_TOP_LEFT;
+  if (str == "bottom-left")
+    return INDICATOR_BOTTOM_LEFT;
+  if (str == "bottom-right")
+    return INDICATOR_BOTTOM_RIGHT;
+  return INDICATOR_TOP_RIGHT;
+}
+
+static eThumbnailFormat parseThumbnailFormat(const std::string &str) {
+  if (str == "rgba8888")
+    return FORMAT_RGBA8888;
+  if (str == "rgb565")
+    return FORMAT_RGB565;
+  return FORMAT_NATIVE;
+}
+
+static Hyprlang::INT configInt(const char *name) {
+  return **(Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE, name)
+               ->getDataStaticPtr();
+}
+
+static float configFloat(const char *name) {
+  return **(Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(PHANDLE, name)
+               ->getDataStaticPtr();
+}
+
+static std::string configString(const char *name) {
+  const auto *VALUE = (Hyprlang::STRING const *)HyprlandAPI::getConfigValue(
+                          PHANDLE, name)
+                          ->getDataStaticPtr();
+  return VALUE && *VALUE ? *VALUE : "";
+}
+
+void reloadHyprViewConfig() {
+  auto config = makeShared<SHyprViewConfig>();
+
+  config->margin = configInt("plugin:hyprview:margin");
+  config->activeBorderColor = configInt("plugin:hyprview:active_border_color");
+  config->inactiveBorderColor =
+      configInt("plugin:hyprview:inactive_border_color");
+  config->borderWidth = configInt("plugin:hyprview:border_width");
+  config->borderRadius = configInt("plugin:hyprview:border_radius");
+  config->bgDim = configFloat("plugin:hyprview:bg_dim");
+
+  config->workspaceIndicatorEnabled =
+      configInt("plugin:hyprview:workspace_indicator_enabled") != 0;
+  config->workspaceIndicatorFontSize =
+      configInt("plugin:hyprview:workspace_indicator_font_size");
+  config->workspaceIndicatorPosition = parseIndicatorPosition(
+      configString("plugin:hyprview:workspace_indicator_position"));
+  config->workspaceIndicatorBgOpacity =
+      configFloat("plugin:hyprview:workspace_indicator_bg_opacity");
+
+  config->windowNameEnabled =
+      configInt("plugin:hyprview:window_name_enabled") != 0;
+  config->windowNameFontSize =
+      configInt("plugin:hyprview:window_name_font_size");
+  config->windowNameBgOpacity =
+      configFloat("plugin:hyprview:window_name_bg_opacity");
+  config->windowTextColor = configInt("plugin:hyprview:window_text_color");
+
+  config->refreshPolicy = parseRefreshPolicy(
+      configString("plugin:hyprview:refresh_policy"), {});
+  config->thumbnailProfile = parseThumbnailProfile(
+      configString("plugin:hyprview:thumbnail_profile"), PROFILE_SURFACE);
+  config->thumbnailFormat =
+      parseThumbnailFormat(configString("plugin:hyprview:thumbnail_format"));
+
+  config->switcherCount =
+      std::max<Hyprlang::INT>(1, configInt("plugin:hyprview:switcher_count"));
+
+  g_hyprViewConfig = config;
+  Debug::log(LOG, "[hyprview] Config snapshot rebuilt");
+}
+
+SP<const SHyprViewConfig> hyprViewConfig() {
+  if (!g_hyprViewConfig)
+    reloadHyprViewConfig();
+  return g_hyprViewConfig;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#define WLR_USE_UNSTABLE
+
+#include "WindowRules.hpp"
+#include <hyprland/src/helpers/Color.hpp>
+#include <hyprland/src/helpers/memory/Memory.hpp>
+
+// Corner of the legacy workspace indicator (workspace_indicator_position)
+enum eIndicatorPosition {
+  INDICATOR_TOP_RIGHT, // Default, also for unknown values
+  INDICATOR_TOP_LEFT,
+  INDICATOR_BOTTOM_LEFT,
+  INDICATOR_BOTTOM_RIGHT,
+};
+
+// thumbnail_format
+enum eThumbnailFormat {
+  FORMAT_NATIVE,
+  FORMAT_RGBA8888,
+  FORMAT_RGB565,
+};
+
+// The plugin:hyprview:* values an overview reads while opening and
+// rendering, parsed once per config reload. Immutable: instances keep the
+// snapshot they were opened with.
+struct SHyprViewConfig {
+  int margin = 10;
+  CHyprColor activeBorderColor;
+  CHyprColor inactiveBorderColor;
+  int borderWidth = 5;
+  int borderRadius = 5;
+  float bgDim = 0.4f;
+
+  bool workspaceIndicatorEnabled = true;
+  int workspaceIndicatorFontSize = 28;
+  eIndicatorPosition workspaceIndicatorPosition = INDICATOR_TOP_RIGHT;
+  float workspaceIndicatorBgOpacity = 0.85f;
+
+  bool windowNameEnabled = true;
+  int windowNameFontSize = 20;
+  float windowNameBgOpacity = 0.85f;
+  CHyprColor windowTextColor;
+
+  SRefreshPolicy refreshPolicy;
+  eThumbnailProfile thumbnailProfile = PROFILE_SURFACE;
+  eThumbnailFormat thumbnailFormat = FORMAT_NATIVE;
+
+  size_t switcherCount = 8;
+};
+
+// Current snapshot, built on first use
+SP<const SHyprViewConfig> hyprViewConfig();
+
+// Builds a new snapshot from the config manager, on configReloaded
+void reloadHyprViewConfig();
@@ -0,0 +1,49 @@
+#include "FocusHistory.hpp"
+#include <hyprland/src/desktop/Window.hpp>
+
+void CFocusHistory::touch(const PHLWINDOW &window) {
+  if (!window)
+    return;
+
+  auto it = m_index.find(window.get());
+  if (it != m_index.end()) {
+    // Move to the front without reallocating the node
+    m_order.splice(m_order.begin(), m_order, it->second);
+    *it->second = window;
+    return;
+  }
+
+  m_order.emplace_front(window);
+  m_index[window.get()] = m_order.begin();
+}
+
+void CFocusHistory::remove(const PHLWINDOW &window) {
+  if (!window)
+    return;
+
+  auto it = m_index.find(window.get());
+  if (it == m_index.end())
+    return;
+
+  m_order.erase(it->second);
+  m_index.erase(it);
+}
+
+void CFocusHistory::clear() {
+  m_order.clear();
+  m_index.clear();
+}
+
+std::vector<PHLWINDOW> CFocusHistory::top(size_t count) const {
+  std::vector<PHLWINDOW> windows;
+  windows.reserve(count);
+  for (const auto &ref : m_order) {
+    if (windows.size() >= count)
+      break;
+
+    auto window = ref.lock();
+    if (window && window->m_isMapped && !window->isHidden())
+      windows.push_back(window);
+  }
+  return windows;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Most recently focused windows first. Kept up to date from the activeWindow
+// and closeWindow events, each update is O(1).
+class CFocusHistory {
+public:
+  void touch(const PHLWINDOW &window);
+  void remove(const PHLWINDOW &window);
+  void clear();
+
+  // Up to count mapped windows, most recent first
+  std::vector<PHLWINDOW> top(size_t count) const;
+
+  size_t size() const { return m_order.size(); }
+
+private:
+  std::list<PHLWINDOWREF> m_order;
+  // Keyed by address, the reference in the list may already be expired
+  std::unordered_map<const CWindow *, std::list<PHLWINDOWREF>::iterator>
+      m_index;
+};
+
+inline CFocusHistory g_focusHistory;
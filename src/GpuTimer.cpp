@@ -0,0 +1,120 @@
+#include "GpuTimer.hpp"
+#include <GLES2/gl2ext.h>
+#include <string_view>
+
+#ifndef GL_TIME_ELAPSED_EXT
+#define GL_TIME_ELAPSED_EXT 0x88BF
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+
+CGpuTimer::~CGpuTimer() {
+  if (m_active)
+    glEndQuery(GL_TIME_ELAPSED_EXT);
+
+  recycle(m_current);
+  for (auto &frame : m_pending)
+    recycle(frame);
+  if (!m_free.empty())
+    glDeleteQueries((GLsizei)m_free.size(), m_free.data());
+}
+
+bool CGpuTimer::supported() const {
+  if (m_supported < 0) {
+    // Null without a current context, asked again next time
+    const auto *EXTENSIONS = (const char *)glGetString(GL_EXTENSIONS);
+    if (!EXTENSIONS)
+      return false;
+    m_supported = std::string_view{EXTENSIONS}.contains(
+        "GL_EXT_disjoint_timer_query");
+  }
+  return m_supported == 1;
+}
+
+GLuint CGpuTimer::acquire() {
+  if (m_free.empty()) {
+    GLuint id = 0;
+    glGenQueries(1, &id);
+    return id;
+  }
+
+  const GLuint ID = m_free.back();
+  m_free.pop_back();
+  return ID;
+}
+
+void CGpuTimer::recycle(SFrame &frame) {
+  for (const auto &query : frame)
+    m_free.push_back(query.id);
+  frame.clear();
+}
+
+void CGpuTimer::begin(ePass pass) {
+  if (m_active || !supported())
+    return;
+
+  const GLuint ID = acquire();
+  glBeginQuery(GL_TIME_ELAPSED_EXT, ID);
+  m_current.push_back({ID, pass});
+  m_active = true;
+}
+
+void CGpuTimer::end() {
+  if (!m_active)
+    return;
+
+  glEndQuery(GL_TIME_ELAPSED_EXT);
+  m_active = false;
+}
+
+void CGpuTimer::endFrame() {
+  end();
+  if (m_current.empty())
+    return;
+
+  m_pending.push_back(std::move(m_current));
+  m_current.clear();
+
+  // Results that never arrive must not pile up
+  while (m_pending.size() > MAX_PENDING_FRAMES) {
+    recycle(m_pending.front());
+    m_pending.pop_front();
+  }
+}
+
+std::vector<CGpuTimer::SFrameTimes> CGpuTimer::collect() {
+  std::vector<SFrameTimes> frames;
+  if (m_pending.empty())
+    return frames;
+
+  while (!m_pending.empty()) {
+    auto &frame = m_pending.front();
+    // Queries finish in order, the last one of a frame is enough
+    GLuint available = 0;
+    glGetQueryObjectuiv(frame.back().id, GL_QUERY_RESULT_AVAILABLE,
+                        &available);
+    if (!available)
+      break;
+
+    SFrameTimes times{};
+    for (const auto &query : frame) {
+      GLuint nanoseconds = 0;
+      glGetQueryObjectuiv(query.id, GL_QUERY_RESULT, &nanoseconds);
+      times[query.pass] += nanoseconds / 1e6;
+    }
+
+    frames.push_back(times);
+    recycle(frame);
+    m_pending.pop_front();
+  }
+
+  // Checked after reading, it also resets the flag. Any of the results read
+  // may be wrong then.
+  GLint disjoint = 0;
+  glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+  if (disjoint)
+    frames.clear();
+
+  return frames;
+}
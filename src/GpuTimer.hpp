@@ -0,0 +1,54 @@
+#pragma once
+#include <GLES3/gl32.h>
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+// GPU time of the overview's own GL work, from GL_EXT_disjoint_timer_query.
+// Queries are grouped per frame and read back a few frames later without
+// stalling the pipeline. Needs the renderer's context current for every call.
+class CGpuTimer {
+public:
+  enum ePass {
+    PASS_RENDER, // fullRender()
+    PASS_REDRAW, // Job drains: captures and tile redraws
+    PASS_COUNT
+  };
+  using SFrameTimes = std::array<double, PASS_COUNT>; // Milliseconds
+
+  ~CGpuTimer();
+
+  // False without the extension, begin() and end() do nothing then
+  bool supported() const;
+
+  // Around GL work of the current frame. Queries of the same target can't
+  // nest, so passes must not overlap.
+  void begin(ePass pass);
+  void end();
+  // Closes the current frame, later queries belong to the next one
+  void endFrame();
+
+  // Frames whose results arrived since the last call, oldest first. Frames
+  // hit by a disjoint event (GPU reset, frequency change) are dropped.
+  std::vector<SFrameTimes> collect();
+
+private:
+  struct SQuery {
+    GLuint id = 0;
+    ePass pass = PASS_RENDER;
+  };
+  using SFrame = std::vector<SQuery>;
+
+  // Frames still unread after this many are dropped
+  static constexpr size_t MAX_PENDING_FRAMES = 8;
+
+  GLuint acquire();
+  void recycle(SFrame &frame);
+
+  mutable int m_supported = -1; // -1 = not checked yet
+  bool m_active = false;
+  SFrame m_current;
+  std::deque<SFrame> m_pending;
+  std::vector<GLuint> m_free;
+};
@@ -2,31 +2,18 @@
 #include "hyprview.hpp"
 #include <hyprland/src/render/OpenGL.hpp>
 
-CHyprViewPassElement::CHyprViewPassElement(CHyprView *instance_)
+CHyprViewPassElement::CHyprViewPassElement(WP<CHyprView *> instance_)
     : instance(instance_) {
   ;
 }
 
 void CHyprViewPassElement::draw(const CRegion &damage) {
+  // The instance may have been closed or deleted since this pass was built
+  auto handle = instance.lock();
+  if (!handle || (*handle)->readyForCleanup)
+    return;
 
-  // Check if the instance still exists in the global map before rendering
-  // This prevents crashes when the instance has been deleted
-  bool instanceStillValid = false;
-  for (auto &[monitor, inst] : g_pHyprViewInstances) {
-    if (inst.get() == instance) {
-      instanceStillValid = true;
-
-      break;
-    }
-  }
-
-  if (!instanceStillValid) {
-
-  } else if (!instance) {
-
-  } else {
-    instance->fullRender();
-  }
+  (*handle)->fullRender();
 }
 
 bool CHyprViewPassElement::needsLiveBlur() { return false; }
@@ -1,11 +1,12 @@
 #pragma once
+#include <hyprland/src/helpers/memory/Memory.hpp>
 #include <hyprland/src/render/pass/PassElement.hpp>
 
 class CHyprView;
 
 class CHyprViewPassElement : public IPassElement {
 public:
-  CHyprViewPassElement(CHyprView *instance_);
+  CHyprViewPassElement(WP<CHyprView *> instance_);
   virtual ~CHyprViewPassElement() = default;
 
   virtual void draw(const CRegion &damage);
@@ -17,5 +18,5 @@ public:
   virtual const char *passName() { return "CHyprViewPassElement"; }
 
 private:
-  CHyprView *instance;
+  WP<CHyprView *> instance;
 };
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "InputRouter.hpp"
+#include "hyprview.hpp"
+#include <algorithm>
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <hyprland/src/managers/input/InputManager.hpp>
+
+void CInputRouter::update() {
+  const bool OPEN = std::ranges::any_of(
+      g_pHyprViewInstances,
+      [](const auto &entry) { return entry.second && !entry.second->closing; });
+
+  if (OPEN && !installed())
+    install();
+  else if (!OPEN && installed())
+    uninstall();
+}
+
+CHyprView *CInputRouter::target(Vector2D &localPos) {
+  const Vector2D GLOBAL = g_pInputManager->getMouseCoordsInternal();
+  const auto MONITOR = g_pCompositor->getMonitorFromVector(GLOBAL);
+  if (!MONITOR)
+    return nullptr;
+
+  auto it = g_pHyprViewInstances.find(MONITOR);
+  if (it == g_pHyprViewInstances.end() || !it->second)
+    return nullptr;
+
+  localPos = GLOBAL - MONITOR->m_position;
+  return it->second.get();
+}
+
+void CInputRouter::install() {
+  // Events on a monitor without an overview are left alone
+  auto onMove = [](void *self, SCallbackInfo &info, std::any param) {
+    Vector2D localPos;
+    if (auto *instance = target(localPos))
+      instance->onPointerMove(localPos, info);
+  };
+
+  auto onButton = [](void *self, SCallbackInfo &info, std::any param) {
+    Vector2D localPos;
+    if (auto *instance = target(localPos))
+      instance->onPointerButton(localPos, info);
+  };
+
+  auto onAxis = [](void *self, SCallbackInfo &info, std::any param) {
+    Vector2D localPos;
+    if (auto *instance = target(localPos))
+      instance->onPointerAxis(localPos, info, param);
+  };
+
+  // Typed text filters the overview the pointer is on
+  auto onKey = [](void *self, SCallbackInfo &info, std::any param) {
+    Vector2D localPos;
+    if (auto *instance = target(localPos))
+      instance->onKey(info, param);
+  };
+
+  m_mouseMove = g_pHookSystem->hookDynamic("mouseMove", onMove);
+  m_touchMove = g_pHookSystem->hookDynamic("touchMove", onMove);
+  m_mouseButton = g_pHookSystem->hookDynamic("mouseButton", onButton);
+  m_mouseAxis = g_pHookSystem->hookDynamic("mouseAxis", onAxis);
+  m_touchDown = g_pHookSystem->hookDynamic("touchDown", onButton);
+  m_keyPress = g_pHookSystem->hookDynamic("keyPress", onKey);
+}
+
+void CInputRouter::uninstall() {
+  m_mouseMove.reset();
+  m_touchMove.reset();
+  m_mouseButton.reset();
+  m_mouseAxis.reset();
+  m_touchDown.reset();
+  m_keyPress.reset();
+}
@@ -0,0 +1,33 @@
+#pragma once
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/managers/HookSystemManager.hpp>
+
+class CHyprView;
+
+// One set of pointer, touch and key hooks for all overviews. Each event
+// resolves the monitor under the cursor once and goes to that monitor's
+// instance only. The hooks exist only while an overview is open.
+class CInputRouter {
+public:
+  // Installs or removes the hooks to match g_pHyprViewInstances
+  void update();
+
+  bool installed() const { return m_mouseMove != nullptr; }
+
+private:
+  // Instance on the monitor under the cursor, cursor relative to it
+  static CHyprView *target(Vector2D &localPos);
+
+  void install();
+  void uninstall();
+
+  SP<HOOK_CALLBACK_FN> m_mouseMove;
+  SP<HOOK_CALLBACK_FN> m_touchMove;
+  SP<HOOK_CALLBACK_FN> m_mouseButton;
+  SP<HOOK_CALLBACK_FN> m_mouseAxis;
+  SP<HOOK_CALLBACK_FN> m_touchDown;
+  SP<HOOK_CALLBACK_FN> m_keyPress;
+};
+
+inline CInputRouter g_inputRouter;
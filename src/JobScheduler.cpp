@@ -0,0 +1,67 @@
+#include "JobScheduler.hpp"
+#include <algorithm>
+#include <chrono>
+
+void CJobScheduler::schedule(eJobKind kind, size_t target, ePriority priority,
+                             std::function<void()> job) {
+  for (auto &pending : m_jobs) {
+    if (pending.kind == kind && pending.target == target) {
+      pending.priority = std::min(pending.priority, priority);
+      pending.run = std::move(job);
+      return;
+    }
+  }
+
+  m_jobs.push_back({kind, target, priority, m_nextSequence++, std::move(job)});
+}
+
+bool CJobScheduler::isPending(eJobKind kind, size_t target) const {
+  return std::ranges::any_of(m_jobs, [&](const SJob &job) {
+    return job.kind == kind && job.target == target;
+  });
+}
+
+bool CJobScheduler::hasPending(ePriority atLeast) const {
+  return std::ranges::any_of(
+      m_jobs, [&](const SJob &job) { return job.priority <= atLeast; });
+}
+
+size_t CJobScheduler::drain(double budgetMs) {
+  if (m_jobs.empty())
+    return 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  auto elapsedMs = [&start] {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  };
+
+  size_t ran = 0;
+  while (!m_jobs.empty() && (ran == 0 || elapsedMs() < budgetMs)) {
+    // Few jobs are ever queued, a linear pick is cheaper than keeping a heap
+    // in sync with priority changes
+    auto next = std::ranges::min_element(m_jobs, [](const SJob &a,
+                                                     const SJob &b) {
+      return a.priority != b.priority ? a.priority < b.priority
+                                      : a.sequence < b.sequence;
+    });
+
+    // Take it out first, running it may schedule new jobs
+    auto run = std::move(next->run);
+    m_jobs.erase(next);
+
+    run();
+    ran++;
+  }
+
+  m_executed += ran;
+  if (!m_jobs.empty())
+    m_carriedOver++;
+
+  m_lastDrainMs = elapsedMs();
+  m_maxDrainMs = std::max(m_maxDrainMs, m_lastDrainMs);
+  return ran;
+}
+
+void CJobScheduler::clear() { m_jobs.clear(); }
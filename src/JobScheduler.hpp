@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Prioritized queue of deferred overview work (thumbnail captures, label
+// rasterization, ...). Drained from preRender within a per-frame time budget,
+// whatever does not fit is left for the next drain.
+class CJobScheduler {
+public:
+  // What a job works on, together with the target index it identifies a job
+  enum eJobKind {
+    JOB_TILE_CAPTURE,   // Capture or refresh a tile framebuffer
+    JOB_HIRES_CAPTURE,  // Full resolution capture of the hovered tile
+    JOB_WINDOW_NAME,    // Rasterize a tile label
+    JOB_SECTION_HEADER, // Rasterize a workspace section header
+    JOB_FILTER_LABEL,   // Rasterize the type-to-filter query
+  };
+
+  // Lower runs first
+  enum ePriority {
+    PRIORITY_HOVERED,
+    PRIORITY_VISIBLE,
+    PRIORITY_LABEL,
+    PRIORITY_CACHE_WARM,
+  };
+
+  // Queues a job. If one is already pending for the same kind and target it
+  // keeps its place and only takes the higher of both priorities.
+  void schedule(eJobKind kind, size_t target, ePriority priority,
+                std::function<void()> job);
+
+  bool isPending(eJobKind kind, size_t target) const;
+
+  // True if any pending job has at least the given priority
+  bool hasPending(ePriority atLeast) const;
+
+  // Runs jobs in priority order until budgetMs is spent. Always runs at least
+  // one job so the queue makes progress on slow frames. Returns jobs run.
+  size_t drain(double budgetMs);
+
+  void clear();
+
+  bool empty() const { return m_jobs.empty(); }
+  size_t pending() const { return m_jobs.size(); }
+  size_t executed() const { return m_executed; }
+  size_t carriedOver() const { return m_carriedOver; }
+  double lastDrainMs() const { return m_lastDrainMs; }
+  double maxDrainMs() const { return m_maxDrainMs; }
+
+private:
+  struct SJob {
+    eJobKind kind;
+    size_t target;
+    ePriority priority;
+    size_t sequence; // FIFO order within a priority
+    std::function<void()> run;
+  };
+
+  std::vector<SJob> m_jobs;
+  size_t m_nextSequence = 0;
+  size_t m_executed = 0;
+  size_t m_carriedOver = 0; // Drains that left work behind
+  double m_lastDrainMs = 0.0;
+  double m_maxDrainMs = 0.0;
+};
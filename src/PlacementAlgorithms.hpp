@@ -1,5 +1,6 @@
 #pragma once
 #include <cstddef>
+#include <string>
 #include <vector>
 
 // Pure data structures for placement algorithms
@@ -50,3 +51,60 @@ PlacementResult widePlacement(const std::vector<WindowInfo> &windows,
 PlacementResult
 scalePlacement(const std::vector<WindowInfo> &windows,
                const ScreenInfo &screen); // Wayfire scale algorithm
+
+// Grouped layouts: the screen is split into one section per group (e.g. one
+// per workspace), each with a header strip and its own placement area
+struct SectionInfo {
+  TileRect header; // Header strip at the top of the section
+  ScreenInfo area; // Area below the header, passed to the placement function
+};
+
+std::vector<SectionInfo> sectionLayout(const std::vector<size_t> &groupSizes,
+                                       const ScreenInfo &screen,
+                                       double headerHeight);
+
+// One section per rectangle (e.g. per monitor of the desktop layout), placed
+// like the rectangles are: the whole arrangement is scaled uniformly to fit
+// the screen and centered on it
+std::vector<SectionInfo>
+arrangedSectionLayout(const std::vector<TileRect> &rects,
+                      const ScreenInfo &screen, double headerHeight);
+
+// Placement algorithm registry - every pure placement function, by name
+using PlacementFunction = PlacementResult (*)(const std::vector<WindowInfo> &,
+                                              const ScreenInfo &);
+
+struct PlacementAlgorithm {
+  const char *name;
+  PlacementFunction function;
+};
+
+const std::vector<PlacementAlgorithm> &placementAlgorithms();
+PlacementFunction findPlacementAlgorithm(const std::string &name); // nullptr if unknown
+
+// Score of one candidate evaluated by the auto placement
+struct PlacementScore {
+  std::string name;
+  double utilization; // Fraction of the screen covered by (aspect-fitted) windows
+  double minScale;    // Smallest window-to-tile scale factor
+  double score;       // Combined score, higher is better
+  double elapsedMs;   // Time the algorithm took on its worker
+  bool completed;     // False if it did not finish within the latency budget
+};
+
+double scorePlacement(const std::vector<WindowInfo> &windows,
+                      const ScreenInfo &screen, const PlacementResult &result,
+                      double *utilization = nullptr,
+                      double *minScale = nullptr);
+
+// Runs every registered algorithm concurrently and returns the best scoring
+// result that finished within budgetMs (falls back to grid otherwise)
+PlacementResult autoPlacement(const std::vector<WindowInfo> &windows,
+                              const ScreenInfo &screen, double budgetMs,
+                              std::vector<PlacementScore> *scores = nullptr);
+
+// Runs the named algorithm ("auto" evaluates all of them), grid if unknown
+PlacementResult runPlacement(const std::string &name,
+                             const std::vector<WindowInfo> &windows,
+                             const ScreenInfo &screen, double autoBudgetMs,
+                             std::vector<PlacementScore> *scores = nullptr);
@@ -0,0 +1,94 @@
+#include "PlacementCache.hpp"
+#include <algorithm>
+#include <functional>
+
+bool CPlacementCache::SKey::operator==(const SKey &other) const {
+  return algorithm == other.algorithm && screen.width == other.screen.width &&
+         screen.height == other.screen.height &&
+         screen.offsetX == other.screen.offsetX &&
+         screen.offsetY == other.screen.offsetY &&
+         screen.margin == other.screen.margin && sizes == other.sizes &&
+         autoBudgetMs == other.autoBudgetMs;
+}
+
+size_t CPlacementCache::hashKey(const SKey &key) {
+  size_t hash = std::hash<std::string>{}(key.algorithm);
+  auto combine = [&hash](double value) {
+    hash ^= std::hash<double>{}(value) + 0x9e3779b97f4a7c15ULL + (hash << 6) +
+            (hash >> 2);
+  };
+
+  combine(key.screen.width);
+  combine(key.screen.height);
+  combine(key.screen.offsetX);
+  combine(key.screen.offsetY);
+  combine(key.screen.margin);
+  combine(key.autoBudgetMs);
+  for (const auto &[width, height] : key.sizes) {
+    combine(width);
+    combine(height);
+  }
+
+  return hash;
+}
+
+PlacementResult CPlacementCache::get(const std::string &algorithm,
+                                     const std::vector<WindowInfo> &windows,
+                                     const ScreenInfo &screen,
+                                     double autoBudgetMs,
+                                     std::vector<PlacementScore> *scores) {
+  // Other algorithms don't depend on the budget, it must not split them
+  SKey key = {algorithm, screen, {},
+              algorithm == "auto" ? autoBudgetMs : 0.0};
+  key.sizes.reserve(windows.size());
+  for (const auto &window : windows)
+    key.sizes.emplace_back(window.width, window.height);
+
+  const size_t hash = hashKey(key);
+
+  auto it = m_index.find(hash);
+  if (it != m_index.end() && it->second->key == key) {
+    m_hits++;
+    // Move to the front (most recently used)
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    if (scores)
+      *scores = it->second->scores;
+    return it->second->result;
+  }
+
+  m_misses++;
+
+  SEntry entry = {hash, std::move(key), {}, {}};
+  entry.result = runPlacement(algorithm, windows, screen, autoBudgetMs,
+                              &entry.scores);
+  if (scores)
+    *scores = entry.scores;
+
+  // A candidate cut off by the budget may win on a less busy frame, and the
+  // fallback must not stick for the session
+  const bool COMPLETE = std::ranges::all_of(
+      entry.scores, [](const PlacementScore &score) { return score.completed; });
+  if (!COMPLETE)
+    return entry.result;
+
+  // Hash collision with a different key - the newer layout wins
+  if (it != m_index.end()) {
+    m_entries.erase(it->second);
+    m_index.erase(it);
+  }
+
+  m_entries.push_front(std::move(entry));
+  m_index[hash] = m_entries.begin();
+
+  while (m_entries.size() > m_capacity) {
+    m_index.erase(m_entries.back().hash);
+    m_entries.pop_back();
+  }
+
+  return m_entries.front().result;
+}
+
+void CPlacementCache::clear() {
+  m_entries.clear();
+  m_index.clear();
+}
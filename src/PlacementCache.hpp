@@ -0,0 +1,56 @@
+#pragma once
+#include "PlacementAlgorithms.hpp"
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Small LRU cache in front of the pure placement functions.
+// Keyed by (algorithm, screen, ordered window sizes, auto budget) only, so it
+// is shared by every monitor with the same geometry and reopening the
+// overview with the same windows returns the exact same tiles. An "auto"
+// result with a candidate over budget is not cached, the next open tries
+// again.
+class CPlacementCache {
+public:
+  explicit CPlacementCache(size_t capacity) : m_capacity(capacity) {}
+
+  PlacementResult get(const std::string &algorithm,
+                      const std::vector<WindowInfo> &windows,
+                      const ScreenInfo &screen, double autoBudgetMs,
+                      std::vector<PlacementScore> *scores = nullptr);
+
+  void clear();
+
+  size_t size() const { return m_entries.size(); }
+  size_t hits() const { return m_hits; }
+  size_t misses() const { return m_misses; }
+
+private:
+  struct SKey {
+    std::string algorithm;
+    ScreenInfo screen;
+    std::vector<std::pair<double, double>> sizes;
+    double autoBudgetMs = 0.0; // Only set for "auto"
+
+    bool operator==(const SKey &other) const;
+  };
+
+  struct SEntry {
+    size_t hash;
+    SKey key;
+    PlacementResult result;
+    std::vector<PlacementScore> scores;
+  };
+
+  static size_t hashKey(const SKey &key);
+
+  size_t m_capacity;
+  std::list<SEntry> m_entries; // Most recently used first
+  std::unordered_map<size_t, std::list<SEntry>::iterator> m_index;
+  size_t m_hits = 0;
+  size_t m_misses = 0;
+};
+
+inline CPlacementCache g_placementCache{16};
@@ -0,0 +1,84 @@
+#include "QualityController.hpp"
+#include <algorithm>
+#include <cmath>
+
+static const SQualitySettings QUALITY_LEVELS[CQualityController::MAX_LEVEL +
+                                             1] = {
+    {1.0, 0.0, 2},   // Full quality
+    {0.75, 30.0, 2}, // Fewer refreshes, slightly smaller captures
+    {0.5, 15.0, 1},  // Half resolution, short labels
+    {0.35, 5.0, 0},  // Minimal: mostly static thumbnails, no labels
+};
+
+const SQualitySettings &CQualityController::settings() const {
+  return QUALITY_LEVELS[m_level];
+}
+
+bool CQualityController::addSample(double frameMs, double redrawMs,
+                                   double intervalMs, double budgetMs,
+                                   bool adaptive) {
+  if (m_samples.size() < WINDOW) {
+    m_samples.push_back(frameMs);
+    m_redrawSamples.push_back(redrawMs);
+  } else {
+    m_samples[m_next] = frameMs;
+    m_redrawSamples[m_next] = redrawMs;
+    m_next = (m_next + 1) % WINDOW;
+  }
+  m_totalSamples++;
+  m_sinceChange++;
+
+  if (!adaptive) {
+    const bool CHANGED = m_level != 0;
+    m_level = 0;
+    return CHANGED;
+  }
+
+  // Wait for enough samples at the current level before judging it
+  if (m_sinceChange < SETTLE || intervalMs <= 0.0)
+    return false;
+
+  // Tail latency is what drops frames, the median hides it. Drains stop
+  // after budgetMs of CPU time; GPU time past that means the captures
+  // themselves are too expensive.
+  const double P95 = percentile(0.95);
+  const double REDRAWP95 = redrawPercentile(0.95);
+  const bool REDRAWLIMIT = budgetMs > 0.0;
+  int newLevel = m_level;
+  if (P95 > intervalMs || (REDRAWLIMIT && REDRAWP95 > budgetMs))
+    newLevel = std::min(m_level + 1, MAX_LEVEL);
+  else if (P95 < intervalMs * 0.5 &&
+           (!REDRAWLIMIT || REDRAWP95 < budgetMs * 0.5))
+    newLevel = std::max(m_level - 1, 0);
+
+  if (newLevel == m_level)
+    return false;
+
+  m_level = newLevel;
+  m_sinceChange = 0;
+  // Samples taken at the old level say nothing about the new one
+  m_samples.clear();
+  m_redrawSamples.clear();
+  m_next = 0;
+  return true;
+}
+
+double CQualityController::percentile(double p) const {
+  return percentileOf(m_samples, p);
+}
+
+double CQualityController::redrawPercentile(double p) const {
+  return percentileOf(m_redrawSamples, p);
+}
+
+double CQualityController::percentileOf(const std::vector<double> &samples,
+                                        double p) {
+  if (samples.empty())
+    return 0.0;
+
+  std::vector<double> sorted = samples;
+  const size_t INDEX = (size_t)std::lround(std::clamp(p, 0.0, 1.0) *
+                                           (double)(sorted.size() - 1));
+  std::ranges::nth_element(sorted, sorted.begin() + INDEX);
+  return sorted[INDEX];
+}
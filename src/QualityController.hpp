@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// What the overview is allowed to spend at a quality level
+struct SQualitySettings {
+  double resolutionScale; // Thumbnail capture resolution factor
+  double maxRefreshFps;   // Cap on thumbnail refreshes, 0 = uncapped
+  int labelDetail;        // 2 = full label, 1 = name only, 0 = no labels
+};
+
+// Feedback controller that steps thumbnail quality down while the measured
+// GPU cost of an overview frame exceeds the monitor's refresh interval, or
+// its captures and redraws alone exceed the job budget, and back up once
+// there is headroom again.
+class CQualityController {
+public:
+  static constexpr int MAX_LEVEL = 3;
+
+  // Records the cost of one frame, frameMs including redrawMs. Returns true
+  // if the level changed.
+  bool addSample(double frameMs, double redrawMs, double intervalMs,
+                 double budgetMs, bool adaptive);
+
+  int level() const { return m_level; }
+  const SQualitySettings &settings() const;
+
+  // p in [0, 1] over the recent window of samples, 0 if there are none
+  double percentile(double p) const;
+  double redrawPercentile(double p) const;
+  size_t sampleCount() const { return m_samples.size(); }
+  size_t totalSamples() const { return m_totalSamples; }
+
+private:
+  static constexpr size_t WINDOW = 120; // Samples kept for percentiles
+  static constexpr size_t SETTLE = 30;  // Samples between level changes
+
+  static double percentileOf(const std::vector<double> &samples, double p);
+
+  std::vector<double> m_samples;       // Ring buffer
+  std::vector<double> m_redrawSamples; // Same slots as m_samples
+  size_t m_next = 0;
+  size_t m_totalSamples = 0;
+  size_t m_sinceChange = 0;
+  int m_level = 0;
+};
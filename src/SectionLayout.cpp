@@ -0,0 +1,105 @@
+#include "PlacementAlgorithms.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+std::vector<SectionInfo> sectionLayout(const std::vector<size_t> &groupSizes,
+                                       const ScreenInfo &screen,
+                                       double headerHeight) {
+  std::vector<SectionInfo> sections;
+
+  const size_t sectionCount = groupSizes.size();
+  if (sectionCount == 0)
+    return sections;
+
+  sections.resize(sectionCount);
+
+  // Near-square arrangement of sections, filled row by row in group order
+  const size_t cols = (size_t)std::ceil(std::sqrt((double)sectionCount));
+  const size_t rows = (sectionCount + cols - 1) / cols;
+  const double rowHeight = screen.height / rows;
+
+  for (size_t row = 0; row < rows; ++row) {
+    const size_t first = row * cols;
+    const size_t last = std::min(sectionCount, first + cols);
+
+    // Sections in a row share its width proportionally to their window count
+    double rowWeight = 0.0;
+    for (size_t i = first; i < last; ++i)
+      rowWeight += std::max<size_t>(1, groupSizes[i]);
+
+    double x = screen.offsetX;
+    const double y = screen.offsetY + row * rowHeight;
+
+    for (size_t i = first; i < last; ++i) {
+      const double width =
+          screen.width * std::max<size_t>(1, groupSizes[i]) / rowWeight;
+
+      sections[i].header = {x + screen.margin, y + screen.margin,
+                            width - 2.0 * screen.margin, headerHeight};
+      sections[i].area = {
+          width,                                                     // width
+          std::max(0.0, rowHeight - headerHeight - screen.margin),   // height
+          x,                                                         // offsetX
+          y + headerHeight + screen.margin,                          // offsetY
+          screen.margin                                              // margin
+      };
+
+      x += width;
+    }
+  }
+
+  return sections;
+}
+
+std::vector<SectionInfo>
+arrangedSectionLayout(const std::vector<TileRect> &rects,
+                      const ScreenInfo &screen, double headerHeight) {
+  std::vector<SectionInfo> sections;
+  if (rects.empty())
+    return sections;
+
+  // Bounding box of the arrangement
+  double minX = rects[0].x;
+  double minY = rects[0].y;
+  double maxX = rects[0].x + rects[0].width;
+  double maxY = rects[0].y + rects[0].height;
+  for (const auto &rect : rects) {
+    minX = std::min(minX, rect.x);
+    minY = std::min(minY, rect.y);
+    maxX = std::max(maxX, rect.x + rect.width);
+    maxY = std::max(maxY, rect.y + rect.height);
+  }
+
+  const double totalWidth = maxX - minX;
+  const double totalHeight = maxY - minY;
+  if (totalWidth <= 0.0 || totalHeight <= 0.0)
+    return sections;
+
+  const double scale =
+      std::min(screen.width / totalWidth, screen.height / totalHeight);
+  const double offsetX = screen.offsetX + (screen.width - totalWidth * scale) / 2.0;
+  const double offsetY =
+      screen.offsetY + (screen.height - totalHeight * scale) / 2.0;
+
+  sections.resize(rects.size());
+  for (size_t i = 0; i < rects.size(); ++i) {
+    const double x = offsetX + (rects[i].x - minX) * scale;
+    const double y = offsetY + (rects[i].y - minY) * scale;
+    const double width = rects[i].width * scale;
+    const double height = rects[i].height * scale;
+
+    sections[i].header = {x + screen.margin, y + screen.margin,
+                          std::max(0.0, width - 2.0 * screen.margin),
+                          headerHeight};
+    sections[i].area = {
+        width,                                                   // width
+        std::max(0.0, height - headerHeight - screen.margin),    // height
+        x,                                                       // offsetX
+        y + headerHeight + screen.margin,                        // offsetY
+        screen.margin                                            // margin
+    };
+  }
+
+  return sections;
+}
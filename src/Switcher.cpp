@@ -0,0 +1,368 @@
+#include "Switcher.hpp"
+#include "FocusHistory.hpp"
+#include "SwitcherPassElement.hpp"
+#include "ThumbnailCapture.hpp"
+#include "globals.hpp"
+#include <algorithm>
+#include <linux/input-event-codes.h>
+#include <ostream>
+
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/debug/Log.hpp>
+#include <hyprland/src/desktop/Window.hpp>
+#include <hyprland/src/desktop/Workspace.hpp>
+#include <hyprland/src/devices/IKeyboard.hpp>
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <hyprland/src/managers/KeybindManager.hpp>
+#include <hyprland/src/managers/input/InputManager.hpp>
+#include <hyprland/src/render/OpenGL.hpp>
+#include <hyprland/src/render/Renderer.hpp>
+#include <hyprland/src/render/pass/RendererHintsPassElement.hpp>
+
+// Share of the monitor width the strip may take, and the widest tile
+constexpr double STRIP_MAX_WIDTH = 0.8;
+constexpr double TILE_MAX_WIDTH = 0.15;
+constexpr double TILE_ASPECT = 0.6;
+
+CSwitcher::CSwitcher(PHLMONITOR monitor, bool reverse)
+    : pMonitor(monitor), openedAt(Time::steadyNow()) {
+  config = hyprViewConfig();
+
+  // Only the top of the focus history is looked at
+  const size_t COUNT = std::max<size_t>(1, config->switcherCount);
+  auto windows = g_focusHistory.top(COUNT);
+
+  // Windows that were never focused since the plugin loaded come last
+  if (windows.size() < COUNT) {
+    for (auto &w : g_pCompositor->m_windows) {
+      if (windows.size() >= COUNT)
+        break;
+      if (!w->m_isMapped || w->isHidden() ||
+          std::ranges::find(windows, w) != windows.end())
+        continue;
+      windows.push_back(w);
+    }
+  }
+
+  tiles.resize(windows.size());
+  for (size_t i = 0; i < windows.size(); ++i)
+    tiles[i].window = windows[i];
+
+  layout();
+
+  // The window focused before is the one alt-tab goes to
+  if (tiles.size() > 1)
+    selected = reverse ? tiles.size() - 1 : 1;
+
+  // Selected tile first, the strip is drawn right away without them
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    jobs.schedule(CJobScheduler::JOB_TILE_CAPTURE, i,
+                  i == selected ? CJobScheduler::PRIORITY_HOVERED
+                                : CJobScheduler::PRIORITY_VISIBLE,
+                  [this, i] { captureTile(i); });
+    jobs.schedule(CJobScheduler::JOB_WINDOW_NAME, i,
+                  CJobScheduler::PRIORITY_LABEL,
+                  [this, i] { rasterizeTitle(i); });
+  }
+
+  // Without a held modifier there is no release to wait for, Enter commits
+  waitForRelease = g_pInputManager->getModsFromAllKBs() != 0;
+  m_keyPress = g_pHookSystem->hookDynamic(
+      "keyPress", [this](void *self, SCallbackInfo &info, std::any param) {
+        onKey(info, param);
+      });
+
+  damage();
+  Debug::log(LOG, "[hyprview] Switcher opened on {} with {} windows",
+             monitor->m_name, tiles.size());
+}
+
+CSwitcher::~CSwitcher() {
+  if (modifierCheck)
+    wl_event_source_remove(modifierCheck);
+
+  g_pHyprRenderer->makeEGLCurrent();
+  tiles.clear();
+  damage();
+}
+
+void CSwitcher::layout() {
+  auto monitor = pMonitor.lock();
+  if (!monitor || tiles.empty())
+    return;
+
+  const auto SIZE = monitor->m_pixelSize;
+  const double PADDING = config->margin;
+  const double LABELHEIGHT = config->windowNameFontSize * 1.5;
+  const double COUNT = tiles.size();
+
+  const double TILEWIDTH = std::min(
+      (SIZE.x * STRIP_MAX_WIDTH - (COUNT + 1) * PADDING) / COUNT,
+      SIZE.x * TILE_MAX_WIDTH);
+  const double TILEHEIGHT = TILEWIDTH * TILE_ASPECT;
+
+  const double WIDTH = COUNT * TILEWIDTH + (COUNT + 1) * PADDING;
+  const double HEIGHT = TILEHEIGHT + LABELHEIGHT + 3 * PADDING;
+  strip = {(SIZE.x - WIDTH) / 2.0, (SIZE.y - HEIGHT) / 2.0, WIDTH, HEIGHT};
+
+  for (size_t i = 0; i < tiles.size(); ++i)
+    tiles[i].box = {strip.x + PADDING + i * (TILEWIDTH + PADDING),
+                    strip.y + PADDING, TILEWIDTH, TILEHEIGHT};
+}
+
+void CSwitcher::captureTile(size_t i) {
+  auto &tile = tiles[i];
+  auto window = tile.window.lock();
+  auto monitor = pMonitor.lock();
+  if (!window || !monitor || !window->m_isMapped)
+    return;
+
+  // Windows on hidden workspaces would have to be migrated first like the
+  // overview does, they only show their title
+  if (!window->m_workspace || !window->m_workspace->m_visible)
+    return;
+
+  const auto SOURCESIZE = window->m_realSize->value() * monitor->m_scale;
+  if (SOURCESIZE.x < 1 || SOURCESIZE.y < 1)
+    return;
+
+  const double RESOLUTION =
+      std::min({1.0, tile.box.width / SOURCESIZE.x,
+                tile.box.height / SOURCESIZE.y});
+  const auto RENDERSIZE = (SOURCESIZE * RESOLUTION).floor();
+  if (RENDERSIZE.x < 1 || RENDERSIZE.y < 1)
+    return;
+
+  const uint32_t FORMAT = thumbnailDrmFormat(config->thumbnailFormat, monitor);
+  if (tile.fb.m_size != RENDERSIZE || tile.fb.m_drmFormat != FORMAT) {
+    tile.fb.release();
+    tile.fb.alloc(RENDERSIZE.x, RENDERSIZE.y, FORMAT);
+  }
+
+  // Same profile rules as the overview's tiles
+  auto profile = config->thumbnailProfile;
+  if (auto rule = findRuleValue(window, "profile"))
+    profile = parseThumbnailProfile(*rule, profile);
+
+  // Temporarily move window to monitor position for rendering
+  const auto REALPOS = window->m_realPosition->value();
+  window->m_realPosition->setValue(monitor->m_position);
+
+  // Kept off until after endRender, where the pass is drawn
+  std::optional<CScopedNoBlur> noBlur;
+  if (profile != PROFILE_FULL)
+    noBlur.emplace(window);
+
+  CRegion damage{0, 0, INT16_MAX, INT16_MAX};
+  g_pHyprRenderer->beginRender(monitor, damage, RENDER_MODE_FULL_FAKE, nullptr,
+                               &tile.fb);
+  g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 0});
+
+  SRenderModifData modif;
+  modif.modifs.emplace_back(SRenderModifData::RMOD_TYPE_SCALE,
+                            (float)RESOLUTION);
+  g_pHyprRenderer->m_renderPass.add(makeUnique<CRendererHintsPassElement>(
+      CRendererHintsPassElement::SData{modif}));
+  g_pHyprRenderer->renderWindow(window, monitor, Time::steadyNow(), false,
+                                profile == PROFILE_SURFACE_POPUPS
+                                    ? RENDER_PASS_ALL
+                                    : RENDER_PASS_MAIN,
+                                false, false);
+  g_pHyprRenderer->m_renderPass.add(makeUnique<CRendererHintsPassElement>(
+      CRendererHintsPassElement::SData{SRenderModifData{}}));
+
+  g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+  g_pHyprRenderer->endRender();
+  noBlur.reset();
+
+  window->m_realPosition->setValue(REALPOS);
+}
+
+void CSwitcher::rasterizeTitle(size_t i) {
+  auto window = tiles[i].window.lock();
+  if (!window)
+    return;
+
+  tiles[i].titleTexture = g_pHyprOpenGL->renderText(
+      window->m_title.empty() ? window->m_initialClass : window->m_title,
+      config->windowTextColor, config->windowNameFontSize, false,
+      "sans-serif");
+}
+
+void CSwitcher::cycle(bool reverse) {
+  if (done || tiles.empty())
+    return;
+
+  selected = reverse ? (selected + tiles.size() - 1) % tiles.size()
+                     : (selected + 1) % tiles.size();
+  damage();
+}
+
+void CSwitcher::commit() {
+  if (done)
+    return;
+
+  done = true;
+  // preRender destroys the switcher, focusing may not schedule a frame
+  damage();
+  if (selected >= tiles.size())
+    return;
+
+  auto window = tiles[selected].window.lock();
+  if (!window || !window->m_isMapped)
+    return;
+
+  // A window on a hidden workspace brings its workspace along
+  auto workspace = window->m_workspace;
+  auto monitor = window->m_monitor.lock();
+  if (workspace && monitor && !workspace->m_isSpecialWorkspace &&
+      monitor->m_activeWorkspace != workspace)
+    monitor->changeWorkspace(workspace);
+
+  g_pCompositor->focusWindow(window);
+  g_pKeybindManager->alterZOrder("top");
+
+  Debug::log(LOG, "[hyprview] Switcher: focused {}", window->m_title);
+}
+
+void CSwitcher::cancel() {
+  done = true;
+  damage();
+}
+
+void CSwitcher::onKey(SCallbackInfo &info, std::any param) {
+  if (done)
+    return;
+
+  auto EMAP = std::any_cast<std::unordered_map<std::string, std::any>>(param);
+  const auto EVENT = std::any_cast<IKeyboard::SKeyEvent>(EMAP["event"]);
+
+  if (EVENT.state == WL_KEYBOARD_KEY_STATE_PRESSED) {
+    if (EVENT.keycode == KEY_ESC) {
+      cancel();
+      info.cancelled = true;
+    } else if (EVENT.keycode == KEY_ENTER) {
+      commit();
+      info.cancelled = true;
+    }
+    return;
+  }
+
+  // The modifier state changes after the key event, look once it settled
+  if (!waitForRelease || modifierCheck)
+    return;
+
+  modifierCheck = wl_event_loop_add_idle(
+      g_pCompositor->m_wlEventLoop,
+      [](void *data) {
+        auto *self = (CSwitcher *)data;
+        // Idle sources are one-shot, the event loop frees it
+        self->modifierCheck = nullptr;
+        if (g_pInputManager->getModsFromAllKBs() == 0)
+          self->commit();
+      },
+      this);
+}
+
+void CSwitcher::onPreRender() {
+  static auto *const *PBUDGET =
+      (Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:frame_budget_ms")
+          ->getDataStaticPtr();
+
+  if (done || jobs.empty())
+    return;
+
+  g_pHyprRenderer->makeEGLCurrent();
+  if (jobs.drain(**PBUDGET) > 0)
+    damage();
+}
+
+void CSwitcher::damage() {
+  auto monitor = pMonitor.lock();
+  if (!monitor)
+    return;
+
+  g_pHyprRenderer->damageMonitor(monitor);
+  g_pCompositor->scheduleFrameForMonitor(monitor);
+}
+
+void CSwitcher::render() {
+  auto monitor = pMonitor.lock();
+  if (done || !monitor || g_pHyprOpenGL->m_renderData.pMonitor != monitor)
+    return;
+
+  g_pHyprRenderer->m_renderPass.add(
+      makeUnique<CSwitcherPassElement>(selfHandle));
+}
+
+void CSwitcher::draw() {
+  if (firstFrameMs < 0.0)
+    firstFrameMs = std::chrono::duration<double, std::milli>(
+                       Time::steadyNow() - openedAt)
+                       .count();
+
+  CRegion damage{0, 0, INT16_MAX, INT16_MAX};
+
+  CHyprOpenGLImpl::SRectRenderData stripData;
+  stripData.round = config->borderRadius * 2;
+  g_pHyprOpenGL->renderRect(
+      strip, CHyprColor(0.0, 0.0, 0.0, config->windowNameBgOpacity),
+      stripData);
+
+  if (tiles.empty())
+    return;
+
+  const double LABELTOP = tiles[0].box.y + tiles[0].box.height + config->margin;
+
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    const auto &tile = tiles[i];
+
+    CHyprOpenGLImpl::SRectRenderData data;
+    data.round = config->borderRadius;
+
+    if (i == selected) {
+      CBox borderBox = tile.box;
+      borderBox.expand(config->borderWidth);
+      borderBox.round();
+      g_pHyprOpenGL->renderRect(borderBox, config->activeBorderColor, data);
+    }
+
+    if (tile.fb.m_size.x > 0) {
+      // Fitted into the tile, centered
+      CBox thumbBox = {tile.box.x + (tile.box.width - tile.fb.m_size.x) / 2.0,
+                       tile.box.y +
+                           (tile.box.height - tile.fb.m_size.y) / 2.0,
+                       tile.fb.m_size.x, tile.fb.m_size.y};
+      thumbBox.round();
+      g_pHyprOpenGL->renderTextureInternal(
+          tile.fb.getTexture(), thumbBox,
+          {.damage = &damage, .a = 1.f, .round = config->borderRadius});
+    } else {
+      g_pHyprOpenGL->renderRect(tile.box, CHyprColor(1.0, 1.0, 1.0, 0.08),
+                                data);
+    }
+
+    if (!tile.titleTexture)
+      continue;
+
+    const double TEXTWIDTH =
+        std::min(tile.titleTexture->m_size.x * 0.8, tile.box.width);
+    const double TEXTHEIGHT = tile.titleTexture->m_size.y * 0.8;
+    CBox textBox = {tile.box.x + (tile.box.width - TEXTWIDTH) / 2.0, LABELTOP,
+                    TEXTWIDTH, TEXTHEIGHT};
+    textBox.round();
+    g_pHyprOpenGL->renderTextureInternal(tile.titleTexture, textBox,
+                                         {.damage = &damage, .a = 1.f});
+  }
+}
+
+void CSwitcher::writeDebugInfo(std::ostream &out) const {
+  auto monitor = pMonitor.lock();
+  out << "Switcher: " << (monitor ? monitor->m_name : "<gone>") << ", "
+      << tiles.size() << " windows, selected " << selected
+      << (waitForRelease ? ", commits on modifier release" : "") << "\n";
+  out << "  First frame: " << firstFrameMs << "ms after open\n";
+  out << "  Jobs: pending=" << jobs.pending() << " executed=" << jobs.executed()
+      << "\n";
+}
@@ -0,0 +1,74 @@
+#pragma once
+#define WLR_USE_UNSTABLE
+
+#include "ConfigSnapshot.hpp"
+#include "JobScheduler.hpp"
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprland/src/helpers/time/Time.hpp>
+#include <hyprland/src/managers/HookSystemManager.hpp>
+#include <hyprland/src/render/Framebuffer.hpp>
+#include <any>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+// Alt-tab style quick switcher (hyprview:toggle switcher): a strip of the
+// most recently focused windows over the desktop. Nothing is migrated and no
+// background is captured; thumbnails and titles are queued as jobs so the
+// first frame only draws the strip. Repeated invocations cycle, releasing all
+// modifiers (or Enter) focuses the selection, Escape cancels.
+class CSwitcher {
+public:
+  CSwitcher(PHLMONITOR monitor, bool reverse);
+  ~CSwitcher();
+
+  // Selects the next window, the previous one with reverse
+  void cycle(bool reverse);
+  // Focuses the selected window and finishes
+  void commit();
+  void cancel();
+
+  void onPreRender();
+  // Adds the pass element when the switcher's monitor is being rendered
+  void render();
+  void draw();
+
+  void writeDebugInfo(std::ostream &out) const;
+
+  PHLMONITORREF pMonitor;
+  bool done = false; // Committed or cancelled, removed on the next preRender
+
+private:
+  struct STile {
+    PHLWINDOWREF window;
+    CBox box; // Thumbnail area on the monitor
+    CFramebuffer fb;
+    SP<CTexture> titleTexture;
+  };
+
+  void layout();
+  void captureTile(size_t i);
+  void rasterizeTitle(size_t i);
+  void onKey(SCallbackInfo &info, std::any param);
+  void damage();
+
+  SP<const SHyprViewConfig> config;
+  std::vector<STile> tiles;
+  CBox strip;
+  size_t selected = 0;
+  bool waitForRelease = false; // Opened from a bind with a modifier held
+
+  CJobScheduler jobs;
+  SP<HOOK_CALLBACK_FN> m_keyPress;
+  wl_event_source *modifierCheck = nullptr; // Runs once modifiers settled
+
+  Time::steady_tp openedAt;
+  double firstFrameMs = -1.0; // Dispatch to first draw
+
+  // CSwitcherPassElement draws through a weak copy: an element still queued
+  // when preRender destroys the switcher after commit() or cancel() draws
+  // nothing
+  SP<CSwitcher *> selfHandle = makeShared<CSwitcher *>(this);
+};
+
+inline std::unique_ptr<CSwitcher> g_pSwitcher;
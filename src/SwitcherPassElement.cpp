@@ -0,0 +1,31 @@
+#include "SwitcherPassElement.hpp"
+#include "Switcher.hpp"
+#include <hyprland/src/render/OpenGL.hpp>
+
+CSwitcherPassElement::CSwitcherPassElement(WP<CSwitcher *> switcher_)
+    : switcher(switcher_) {
+  ;
+}
+
+void CSwitcherPassElement::draw(const CRegion &damage) {
+  // The switcher may have been committed since this pass was built
+  auto handle = switcher.lock();
+  if (!handle || (*handle)->done)
+    return;
+
+  (*handle)->draw();
+}
+
+bool CSwitcherPassElement::needsLiveBlur() { return false; }
+
+bool CSwitcherPassElement::needsPrecomputeBlur() { return false; }
+
+std::optional<CBox> CSwitcherPassElement::boundingBox() {
+  // Return nullopt for unbounded rendering
+  return std::nullopt;
+}
+
+CRegion CSwitcherPassElement::opaqueRegion() {
+  // Drawn over the windows, hides nothing completely
+  return CRegion{};
+}
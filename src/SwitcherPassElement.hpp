@@ -0,0 +1,22 @@
+#pragma once
+#include <hyprland/src/helpers/memory/Memory.hpp>
+#include <hyprland/src/render/pass/PassElement.hpp>
+
+class CSwitcher;
+
+class CSwitcherPassElement : public IPassElement {
+public:
+  CSwitcherPassElement(WP<CSwitcher *> switcher_);
+  virtual ~CSwitcherPassElement() = default;
+
+  virtual void draw(const CRegion &damage);
+  virtual bool needsLiveBlur();
+  virtual bool needsPrecomputeBlur();
+  virtual std::optional<CBox> boundingBox();
+  virtual CRegion opaqueRegion();
+
+  virtual const char *passName() { return "CSwitcherPassElement"; }
+
+private:
+  WP<CSwitcher *> switcher;
+};
@@ -0,0 +1,41 @@
+#include "ThumbnailCapture.hpp"
+#include <drm_fourcc.h>
+#define private public
+#include <hyprland/src/desktop/Window.hpp>
+#include <hyprland/src/helpers/Format.hpp>
+#include <hyprland/src/helpers/Monitor.hpp>
+#undef private
+
+uint32_t thumbnailDrmFormat(eThumbnailFormat format, const PHLMONITOR &monitor) {
+  const uint32_t NATIVE = monitor->m_output->state->state().drmFormat;
+  uint32_t drmFormat = NATIVE;
+  if (format == FORMAT_RGBA8888)
+    drmFormat = DRM_FORMAT_ABGR8888;
+  else if (format == FORMAT_RGB565)
+    drmFormat = DRM_FORMAT_RGB565;
+
+  // Only formats the renderer knows how to allocate
+  if (!NFormatUtils::getPixelFormatFromDRM(drmFormat))
+    return NATIVE;
+
+  return drmFormat;
+}
+
+CScopedNoBlur::CScopedNoBlur(const PHLWINDOW &window) : m_window(window) {
+  auto &values = window->m_windowData.noBlur.m_values;
+  if (auto it = values.find(PRIORITY_SET_PROP); it != values.end())
+    m_saved = it->second;
+  values[PRIORITY_SET_PROP] = true;
+}
+
+CScopedNoBlur::~CScopedNoBlur() {
+  auto window = m_window.lock();
+  if (!window)
+    return;
+
+  auto &values = window->m_windowData.noBlur.m_values;
+  if (m_saved)
+    values[PRIORITY_SET_PROP] = *m_saved;
+  else
+    values.erase(PRIORITY_SET_PROP);
+}
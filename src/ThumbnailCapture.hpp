@@ -0,0 +1,32 @@
+#pragma once
+#define WLR_USE_UNSTABLE
+
+#include "ConfigSnapshot.hpp"
+#include <cstdint>
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <optional>
+
+// Shared by every thumbnail capture path (overview tiles, workspace
+// thumbnails, atlas pages, switcher tiles)
+
+// Framebuffer format for thumbnails of monitor: the thumbnail_format choice,
+// or the monitor's own format for native and whatever the renderer can't
+// allocate
+uint32_t thumbnailDrmFormat(eThumbnailFormat format, const PHLMONITOR &monitor);
+
+// Blur is the expensive part of a decorated capture. Lightweight profiles
+// switch it off for the duration of the capture, per window through the
+// highest priority of its own noBlur override (the global config is never
+// touched). Whatever that priority held before is put back.
+class CScopedNoBlur {
+public:
+  explicit CScopedNoBlur(const PHLWINDOW &window);
+  ~CScopedNoBlur();
+
+  CScopedNoBlur(const CScopedNoBlur &) = delete;
+  CScopedNoBlur &operator=(const CScopedNoBlur &) = delete;
+
+private:
+  PHLWINDOWREF m_window;
+  std::optional<bool> m_saved;
+};
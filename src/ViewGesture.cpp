@@ -14,11 +14,11 @@ void CViewGesture::begin(const ITrackpadGesture::STrackpadGestureBegin &e) {
     return;
 
   auto it = g_pHyprViewInstances.find(PMONITOR);
-  if (it == g_pHyprViewInstances.end() || !it->second) {
-    // Create overview for this monitor
-    g_pHyprViewInstances[PMONITOR] = std::make_unique<CHyprView>(
-        PMONITOR, PMONITOR->m_activeWorkspace, true,
-        EWindowCollectionMode::CURRENT_ONLY, "grid");
+  if (it == g_pHyprViewInstances.end() || !it->second || it->second->closing) {
+    // Create overview for this monitor, or take back a closing one
+    g_pHyprViewInstances[PMONITOR] =
+        openHyprView(PMONITOR, PMONITOR->m_activeWorkspace, true,
+                     EWindowCollectionMode::CURRENT_ONLY, "grid");
   } else {
     // Close the overview - but don't call selectHoveredWindow()
     // The gesture swipe is not an explicit selection
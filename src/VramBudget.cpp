@@ -0,0 +1,116 @@
+#include "VramBudget.hpp"
+#include "hyprview.hpp"
+#include <algorithm>
+#include <hyprland/src/debug/Log.hpp>
+
+size_t CVramBudget::limit() const {
+  static auto *const *PBUDGET =
+      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:vram_budget_mb")
+          ->getDataStaticPtr();
+
+  return **PBUDGET > 0 ? (size_t)**PBUDGET * 1024 * 1024 : 0;
+}
+
+size_t CVramBudget::used() const {
+  size_t total = 0;
+  for (const auto &[monitor, instance] : g_pHyprViewInstances) {
+    if (instance)
+      total += instance->vramUsage().total();
+  }
+  for (const auto &[monitor, instance] : g_pHyprViewDormant) {
+    if (instance)
+      total += instance->vramUsage().total();
+  }
+  return total;
+}
+
+void CVramBudget::enforce() {
+  const size_t LIMIT = limit();
+  if (LIMIT == 0 ||
+      (g_pHyprViewInstances.empty() && g_pHyprViewDormant.empty()))
+    return;
+
+  size_t usage = used();
+
+  // Dormant overviews are only a head start for the next open, they go first
+  if (usage > LIMIT && !g_pHyprViewDormant.empty()) {
+    m_evictions += g_pHyprViewDormant.size();
+    g_pHyprViewDormant.clear();
+    usage = used();
+  }
+  const auto NOW = Time::steadyNow();
+  const bool CANSCALE = NOW - m_lastScaleChange >= SCALE_COOLDOWN;
+
+  if (usage <= LIMIT) {
+    if (!CANSCALE)
+      return;
+
+    // Give resolution back one step at a time, while doubling the thumbnails
+    // of an instance (four times the area) still fits with some headroom
+    for (auto &[monitor, instance] : g_pHyprViewInstances) {
+      if (!instance || instance->closing || instance->vramScale() >= 1.0)
+        continue;
+
+      const size_t GROWTH = instance->vramUsage().thumbnails * 3;
+      if ((double)(usage + GROWTH) < LIMIT * 0.9 &&
+          instance->scaleThumbnails(false)) {
+        m_lastScaleChange = NOW;
+        return;
+      }
+    }
+    return;
+  }
+
+  // Least recently visible first, over all instances
+  struct SVictim {
+    CHyprView *instance;
+    CHyprView::SEvictionCandidate candidate;
+  };
+
+  std::vector<SVictim> victims;
+  for (auto &[monitor, instance] : g_pHyprViewInstances) {
+    if (!instance)
+      continue;
+    for (const auto &candidate : instance->evictionCandidates())
+      victims.push_back({instance.get(), candidate});
+  }
+
+  std::ranges::sort(victims, [](const SVictim &a, const SVictim &b) {
+    return a.candidate.lastVisible < b.candidate.lastVisible;
+  });
+
+  for (const auto &victim : victims) {
+    if (usage <= LIMIT)
+      return;
+
+    victim.instance->evictThumbnail(victim.candidate.tile);
+    usage -= std::min(usage, victim.candidate.bytes);
+    m_evictions++;
+  }
+
+  if (usage <= LIMIT || !CANSCALE)
+    return;
+
+  // Everything left is on screen: shrink the instance holding the most
+  CHyprView *largest = nullptr;
+  size_t largestBytes = 0;
+  for (auto &[monitor, instance] : g_pHyprViewInstances) {
+    if (!instance || instance->closing)
+      continue;
+
+    const auto USAGE = instance->vramUsage();
+    const size_t BYTES = USAGE.thumbnails + USAGE.atlas;
+    if (BYTES > largestBytes && instance->vramScale() > 0.125) {
+      largest = instance.get();
+      largestBytes = BYTES;
+    }
+  }
+
+  if (largest && largest->scaleThumbnails(true)) {
+    m_lastScaleChange = NOW;
+    m_downscales++;
+    Debug::log(LOG, "[hyprview] VRAM budget exceeded ({} of {} bytes)", usage,
+               LIMIT);
+  }
+}
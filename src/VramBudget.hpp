@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <hyprland/src/helpers/time/Time.hpp>
+
+// Plugin wide cap on framebuffer memory of all open overviews
+// (vram_budget_mb). Run once per frame after the instances' preRender work:
+// over the limit it drops dormant instances (resident) first, then evicts the
+// least recently visible off-screen thumbnails. If that is not enough it
+// halves the thumbnail size of the biggest instance.
+// Evicted tiles are captured again once they are back on screen.
+class CVramBudget {
+public:
+  void enforce();
+
+  // Bytes held by all instances
+  size_t used() const;
+  size_t limit() const;
+
+  size_t evictions() const { return m_evictions; }
+  size_t downscales() const { return m_downscales; }
+
+private:
+  // Recaptures after a scale change take a few frames to land
+  static constexpr auto SCALE_COOLDOWN = std::chrono::milliseconds(500);
+
+  size_t m_evictions = 0;
+  size_t m_downscales = 0;
+  Time::steady_tp m_lastScaleChange;
+};
+
+inline CVramBudget g_vramBudget;
@@ -0,0 +1,114 @@
+#include "WindowRules.hpp"
+#include <format>
+#include <hyprland/src/desktop/Window.hpp>
+#include <hyprutils/string/String.hpp>
+
+using namespace Hyprutils::String;
+
+std::optional<std::string> addHyprViewRule(const std::string &rhs) {
+  const auto COMMA = rhs.find(',');
+  if (COMMA == std::string::npos)
+    return "Expected <property>:<value>, <class|title>:<regex>";
+
+  const std::string RULE = trim(rhs.substr(0, COMMA));
+  const std::string MATCHER = trim(rhs.substr(COMMA + 1));
+
+  const auto RULECOLON = RULE.find(':');
+  if (RULECOLON == std::string::npos || RULECOLON == 0)
+    return std::format("Invalid rule: {}", RULE);
+
+  SHyprViewRule rule;
+  rule.property = RULE.substr(0, RULECOLON);
+  rule.value = RULE.substr(RULECOLON + 1);
+
+  if (MATCHER.starts_with("class:")) {
+    rule.matchTitle = false;
+  } else if (MATCHER.starts_with("title:")) {
+    rule.matchTitle = true;
+  } else {
+    return std::format("Invalid matcher: {}", MATCHER);
+  }
+
+  try {
+    rule.match = std::regex(MATCHER.substr(6));
+  } catch (const std::regex_error &e) {
+    return std::format("Invalid regex in {}: {}", MATCHER, e.what());
+  }
+
+  g_hyprViewRules.push_back(std::move(rule));
+  return std::nullopt;
+}
+
+std::optional<std::string> findRuleValue(const PHLWINDOW &window,
+                                         const std::string &property) {
+  if (!window)
+    return std::nullopt;
+
+  std::optional<std::string> value;
+  for (const auto &rule : g_hyprViewRules) {
+    if (rule.property != property)
+      continue;
+
+    const auto &SUBJECT =
+        rule.matchTitle ? window->m_title : window->m_initialClass;
+    if (std::regex_search(SUBJECT, rule.match))
+      value = rule.value; // Later rules win
+  }
+
+  return value;
+}
+
+SRefreshPolicy parseRefreshPolicy(const std::string &str,
+                                  const SRefreshPolicy &fallback) {
+  if (str == "live")
+    return {SRefreshPolicy::LIVE, 0.0};
+  if (str == "static")
+    return {SRefreshPolicy::STATIC, 0.0};
+
+  if (str.starts_with("fps:")) {
+    try {
+      const double FPS = std::stod(str.substr(4));
+      if (FPS > 0.0)
+        return {SRefreshPolicy::FPS, FPS};
+    } catch (...) {
+      // Fall through to the fallback
+    }
+  }
+
+  return fallback;
+}
+
+std::string refreshPolicyToString(const SRefreshPolicy &policy) {
+  switch (policy.mode) {
+  case SRefreshPolicy::LIVE:
+    return "live";
+  case SRefreshPolicy::FPS:
+    return std::format("fps:{}", policy.fps);
+  case SRefreshPolicy::STATIC:
+    return "static";
+  }
+  return "live";
+}
+
+eThumbnailProfile parseThumbnailProfile(const std::string &str,
+                                        eThumbnailProfile fallback) {
+  if (str == "full")
+    return PROFILE_FULL;
+  if (str == "surface")
+    return PROFILE_SURFACE;
+  if (str == "surface_popups")
+    return PROFILE_SURFACE_POPUPS;
+  return fallback;
+}
+
+std::string thumbnailProfileToString(eThumbnailProfile profile) {
+  switch (profile) {
+  case PROFILE_FULL:
+    return "full";
+  case PROFILE_SURFACE:
+    return "surface";
+  case PROFILE_SURFACE_POPUPS:
+    return "surface_popups";
+  }
+  return "surface";
+}
@@ -0,0 +1,54 @@
+#pragma once
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <optional>
+#include <regex>
+#include <string>
+#include <vector>
+
+// Per-window overrides, set with
+//   hyprview-rule = <property>:<value>, <class|title>:<regex>
+// e.g. hyprview-rule = refresh:fps:5, class:^(mpv)$
+struct SHyprViewRule {
+  std::string property; // e.g. "refresh"
+  std::string value;    // e.g. "fps:5"
+  bool matchTitle = false;
+  std::regex match;
+};
+
+inline std::vector<SHyprViewRule> g_hyprViewRules;
+
+// Parses the right-hand side of a hyprview-rule line, error message on failure
+std::optional<std::string> addHyprViewRule(const std::string &rhs);
+
+// Value of the last matching rule for property, if any
+std::optional<std::string> findRuleValue(const PHLWINDOW &window,
+                                         const std::string &property);
+
+// How often a thumbnail may be redrawn after its window reports damage
+struct SRefreshPolicy {
+  enum eMode {
+    LIVE,   // On every damage
+    FPS,    // At most fps times per second
+    STATIC, // Never after the initial capture
+  } mode = LIVE;
+  double fps = 0.0;
+};
+
+// Accepts "live", "static" and "fps:N", fallback for anything else
+SRefreshPolicy parseRefreshPolicy(const std::string &str,
+                                  const SRefreshPolicy &fallback);
+std::string refreshPolicyToString(const SRefreshPolicy &policy);
+
+// What a thumbnail capture renders of a window
+enum eThumbnailProfile {
+  PROFILE_FULL,           // As on screen, including blur
+  PROFILE_SURFACE,        // Window surfaces only, no blur
+  PROFILE_SURFACE_POPUPS, // Surfaces and popups, no blur
+};
+
+// Accepts "full", "surface" and "surface_popups", fallback for anything else
+eThumbnailProfile parseThumbnailProfile(const std::string &str,
+                                        eThumbnailProfile fallback);
+std::string thumbnailProfileToString(eThumbnailProfile profile);
@@ -0,0 +1,219 @@
+#include "WindowSearch.hpp"
+#include <algorithm>
+#include <numeric>
+
+// Up to three bytes and the gram length in one key, grams of different
+// lengths never collide
+static uint32_t gramKey(const std::string &text, size_t pos, size_t length) {
+  uint32_t key = (uint32_t)length << 24;
+  for (size_t i = 0; i < length; ++i)
+    key |= (uint32_t)(unsigned char)text[pos + i] << (8 * i);
+  return key;
+}
+
+static std::vector<std::string> splitTerms(const std::string &query) {
+  std::vector<std::string> terms;
+  std::string term;
+  for (char c : query) {
+    if (c == ' ' || c == '\t') {
+      if (!term.empty())
+        terms.push_back(std::move(term));
+      term.clear();
+    } else {
+      term += c;
+    }
+  }
+  if (!term.empty())
+    terms.push_back(std::move(term));
+  return terms;
+}
+
+std::string CWindowSearchIndex::normalize(const std::string &text) {
+  std::string lower = text;
+  // ASCII only, UTF-8 sequences are matched byte for byte
+  for (auto &c : lower) {
+    if (c >= 'A' && c <= 'Z')
+      c = (char)(c - 'A' + 'a');
+  }
+  return lower;
+}
+
+std::vector<uint32_t> CWindowSearchIndex::gramsOf(const std::string &text) {
+  std::vector<uint32_t> grams;
+  for (size_t length = 1; length <= 3; ++length) {
+    for (size_t pos = 0; pos + length <= text.size(); ++pos)
+      grams.push_back(gramKey(text, pos, length));
+  }
+  std::ranges::sort(grams);
+  grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+  return grams;
+}
+
+bool CWindowSearchIndex::fuzzyMatch(const std::string &text,
+                                    const std::string &query) {
+  size_t next = 0;
+  for (char c : query) {
+    if (c == ' ' || c == '\t')
+      continue;
+    next = text.find(c, next);
+    if (next == std::string::npos)
+      return false;
+    next++;
+  }
+  return true;
+}
+
+void CWindowSearchIndex::build(const std::vector<std::string> &texts) {
+  clear();
+  m_texts.reserve(texts.size());
+  for (const auto &text : texts) {
+    m_texts.push_back(normalize(text));
+    addPostings(m_texts.size() - 1);
+  }
+}
+
+void CWindowSearchIndex::update(size_t id, const std::string &text) {
+  if (id >= m_texts.size())
+    return;
+
+  auto lower = normalize(text);
+  if (lower == m_texts[id])
+    return;
+
+  removePostings(id);
+  m_texts[id] = std::move(lower);
+  addPostings(id);
+  m_lastValid = false;
+}
+
+void CWindowSearchIndex::clear() {
+  m_texts.clear();
+  m_postings.clear();
+  m_lastQuery.clear();
+  m_lastResult.clear();
+  m_lastFuzzy = false;
+  m_lastValid = false;
+  m_lastCompared = 0;
+}
+
+void CWindowSearchIndex::addPostings(size_t id) {
+  for (auto gram : gramsOf(m_texts[id])) {
+    auto &ids = m_postings[gram];
+    ids.insert(std::ranges::lower_bound(ids, id), id);
+  }
+}
+
+void CWindowSearchIndex::removePostings(size_t id) {
+  for (auto gram : gramsOf(m_texts[id])) {
+    auto it = m_postings.find(gram);
+    if (it == m_postings.end())
+      continue;
+
+    auto &ids = it->second;
+    auto pos = std::ranges::lower_bound(ids, id);
+    if (pos != ids.end() && *pos == id)
+      ids.erase(pos);
+    if (ids.empty())
+      m_postings.erase(it);
+  }
+}
+
+std::vector<size_t>
+CWindowSearchIndex::candidatesFor(const std::string &term) const {
+  // Short terms are a gram themselves, longer ones need all their trigrams
+  std::vector<uint32_t> grams;
+  if (term.size() <= 3) {
+    grams.push_back(gramKey(term, 0, term.size()));
+  } else {
+    for (size_t pos = 0; pos + 3 <= term.size(); ++pos)
+      grams.push_back(gramKey(term, pos, 3));
+  }
+
+  std::vector<const std::vector<size_t> *> lists;
+  for (auto gram : grams) {
+    auto it = m_postings.find(gram);
+    if (it == m_postings.end())
+      return {};
+    lists.push_back(&it->second);
+  }
+
+  // Intersect starting from the rarest gram
+  std::ranges::sort(lists, {}, [](const auto *ids) { return ids->size(); });
+  std::vector<size_t> result = *lists.front();
+  for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+    std::vector<size_t> narrowed;
+    std::ranges::set_intersection(result, *lists[i],
+                                  std::back_inserter(narrowed));
+    result = std::move(narrowed);
+  }
+  return result;
+}
+
+bool CWindowSearchIndex::matchesTerms(
+    size_t id, const std::vector<std::string> &terms) const {
+  return std::ranges::all_of(terms, [&](const std::string &term) {
+    return m_texts[id].find(term) != std::string::npos;
+  });
+}
+
+const std::vector<size_t> &
+CWindowSearchIndex::search(const std::string &query) {
+  const auto QUERY = normalize(query);
+  const auto TERMS = splitTerms(QUERY);
+  m_lastCompared = 0;
+
+  if (TERMS.empty()) {
+    m_lastResult.resize(m_texts.size());
+    std::iota(m_lastResult.begin(), m_lastResult.end(), 0);
+    m_lastQuery.clear();
+    m_lastFuzzy = false;
+    m_lastValid = true;
+    return m_lastResult;
+  }
+
+  // Anything matching the longer query matched the shorter one, in the same
+  // mode: a term that is found is found with fewer characters too, and so is
+  // a fuzzy sequence
+  const bool NARROW = m_lastValid && !m_lastQuery.empty() &&
+                      QUERY.starts_with(m_lastQuery);
+
+  std::vector<size_t> result;
+  if (!NARROW || !m_lastFuzzy) {
+    std::vector<size_t> candidates;
+    if (NARROW) {
+      candidates = m_lastResult;
+    } else {
+      // The longest term has the fewest candidates, the others only verify
+      const auto &LONGEST = *std::ranges::max_element(
+          TERMS, {}, [](const std::string &term) { return term.size(); });
+      candidates = candidatesFor(LONGEST);
+    }
+
+    for (auto id : candidates) {
+      m_lastCompared++;
+      if (matchesTerms(id, TERMS))
+        result.push_back(id);
+    }
+  }
+
+  bool fuzzy = false;
+  if (result.empty()) {
+    // No exact match for the previous query means none for this one either,
+    // the fuzzy result still narrows. Coming from exact it starts over.
+    fuzzy = true;
+    const bool FROMFUZZY = NARROW && m_lastFuzzy;
+    const size_t COUNT = FROMFUZZY ? m_lastResult.size() : m_texts.size();
+    for (size_t i = 0; i < COUNT; ++i) {
+      const size_t ID = FROMFUZZY ? m_lastResult[i] : i;
+      m_lastCompared++;
+      if (fuzzyMatch(m_texts[ID], QUERY))
+        result.push_back(ID);
+    }
+  }
+
+  m_lastQuery = QUERY;
+  m_lastResult = std::move(result);
+  m_lastFuzzy = fuzzy;
+  m_lastValid = true;
+  return m_lastResult;
+}
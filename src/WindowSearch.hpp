@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Search index over the tile texts (class and title) for type-to-filter.
+// Every 1-, 2- and 3-byte gram of a text has a posting list, so a query term
+// is narrowed to the texts containing all of its grams before any string is
+// compared. A query extending the previous one only looks at the previous
+// result.
+class CWindowSearchIndex {
+public:
+  void build(const std::vector<std::string> &texts);
+  // Replaces the text of one id, e.g. after a title change
+  void update(size_t id, const std::string &text);
+  void clear();
+
+  // Ids matching query, ascending. Every whitespace separated term must occur
+  // in the text (case insensitive). If no text has them all, falls back to
+  // fuzzy: the query's characters in order, anywhere in the text.
+  const std::vector<size_t> &search(const std::string &query);
+
+  size_t size() const { return m_texts.size(); }
+  bool lastWasFuzzy() const { return m_lastFuzzy; }
+  // Texts compared by the last search, the rest were ruled out by the index
+  size_t lastCompared() const { return m_lastCompared; }
+
+private:
+  static std::string normalize(const std::string &text);
+  static std::vector<uint32_t> gramsOf(const std::string &text);
+  static bool fuzzyMatch(const std::string &text, const std::string &query);
+
+  void addPostings(size_t id);
+  void removePostings(size_t id);
+  std::vector<size_t> candidatesFor(const std::string &term) const;
+  bool matchesTerms(size_t id, const std::vector<std::string> &terms) const;
+
+  std::vector<std::string> m_texts; // Lowercased
+  std::unordered_map<uint32_t, std::vector<size_t>> m_postings; // Sorted ids
+
+  // Last search, reused when the next query extends it
+  std::string m_lastQuery;
+  std::vector<size_t> m_lastResult;
+  bool m_lastFuzzy = false;
+  bool m_lastValid = false;
+  size_t m_lastCompared = 0;
+};
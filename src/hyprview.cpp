@@ -1,7 +1,10 @@
 #include "hyprview.hpp"
 #include <algorithm>
 #include <any>
+#include <cmath>
+#include <linux/input-event-codes.h>
 #include <numeric>
+#include <ostream>
 #include <ranges>
 #include <unordered_set>
 #define private public
@@ -9,34 +12,21 @@
 #include <hyprland/src/config/ConfigManager.hpp>
 #include <hyprland/src/config/ConfigValue.hpp>
 #include <hyprland/src/debug/Log.hpp>
+#include <hyprland/src/devices/IKeyboard.hpp>
+#include <hyprland/src/devices/IPointer.hpp>
+#include <hyprland/src/helpers/Format.hpp>
 #include <hyprland/src/helpers/time/Time.hpp>
 #include <hyprland/src/managers/KeybindManager.hpp>
 #include <hyprland/src/managers/animation/AnimationManager.hpp>
 #include <hyprland/src/managers/animation/DesktopAnimationManager.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
 #include <hyprland/src/render/Renderer.hpp>
+#include <hyprland/src/render/pass/RendererHintsPassElement.hpp>
 #undef private
 #include "HyprViewPassElement.hpp"
-#include "PlacementAlgorithms.hpp"
-
-// Helper to find the CHyprView instance for a given animation variable
-CHyprView *findInstanceForAnimation(
-    WP<Hyprutils::Animation::CBaseAnimatedVariable> thisptr) {
-  for (auto &[monitor, instance] : g_pHyprViewInstances) {
-    if (instance && (instance->size.get() == thisptr.lock().get() ||
-                     instance->pos.get() == thisptr.lock().get() ||
-                     instance->scale.get() == thisptr.lock().get())) {
-      return instance.get();
-    }
-  }
-  return nullptr;
-}
-
-void damageMonitor(WP<Hyprutils::Animation::CBaseAnimatedVariable> thisptr) {
-  auto *instance = findInstanceForAnimation(thisptr);
-  if (instance)
-    instance->damage();
-}
+#include "PlacementCache.hpp"
+#include "ThumbnailCapture.hpp"
+#include <xkbcommon/xkbcommon.h>
 
 static float lerp(const float &from, const float &to, const float perc) {
   return (to - from) * perc + from;
@@ -46,32 +36,52 @@ static Vector2D lerp(const Vector2D &from, const Vector2D &to, const float perc)
   return Vector2D{lerp(from.x, to.x, perc), lerp(from.y, to.y, perc)};
 }
 
+// Pixels scrolled per unit of pointer axis delta
+constexpr double SCROLL_SPEED = 5.0;
+
+// Captures at least this many times larger than their tile get mipmaps
+constexpr double MIPMAP_MIN_RATIO = 2.0;
+
+// Monitor sized atlas pages; tiles that do not fit use their own framebuffer
+constexpr size_t ATLAS_MAX_PAGES = 4;
+
 CHyprView::~CHyprView() {
 
+  if (refreshTimer)
+    wl_event_source_remove(refreshTimer);
+  if (idleSource)
+    wl_event_source_remove(idleSource);
+
   // If close() wasn't called, do cleanup here
   if (!closing) {
     // Restore all windows to their original workspaces
     for (const auto &image : images) {
       auto window = image.pWindow.lock();
-      if (window && image.originalWorkspace &&
-          window->m_workspace != image.originalWorkspace) {
+      auto original = image.originalWorkspace.lock();
+      if (window && original && window->m_workspace != original) {
         Debug::log(LOG,
                    "[hyprview] ~CHyprView(): Restoring window '{}' from workspace {} to {}",
-                   window->m_title, window->m_workspace->m_id,
-                   image.originalWorkspace->m_id);
-        window->moveToWorkspace(image.originalWorkspace);
+                   window->m_title, window->m_workspace->m_id, original->m_id);
+        window->moveToWorkspace(original);
       }
     }
   }
 
   // Always cleanup resources in destructor if they haven't been cleaned yet
-  if (!images.empty() || bgFramebuffer.m_size.x > 0) {
+  if (!images.empty() || bgFramebuffer.m_size.x > 0 ||
+      hiResFb.m_size.x > 0 || !atlasPages.empty()) {
     Debug::log(LOG, "[hyprview] ~CHyprView(): Cleaning up remaining resources");
     g_pHyprRenderer->makeEGLCurrent();
     images.clear();
+    atlasPages.clear();
+    atlasPacker.reset();
+    hiResFb.release();
     bgFramebuffer.release();
-    g_pInputManager->unsetCursorImage();
-    g_pHyprOpenGL->markBlurDirtyForMonitor(pMonitor.lock());
+    // A dormant instance gave the cursor back when it closed
+    if (!readyForCleanup) {
+      g_pInputManager->unsetCursorImage();
+      g_pHyprOpenGL->markBlurDirtyForMonitor(pMonitor.lock());
+    }
   }
 }
 
@@ -86,9 +96,11 @@ void CHyprView::setupWindowImages(std::vector<PHLWINDOW> &windowsToRender) {
     originalWorkspaces[window] = window->m_workspace;
   }
 
-  // Move windows to active workspace so they have valid surfaces for rendering
+  // Move windows to active workspace so they have valid surfaces for rendering.
+  // Global tiles are all on a visible workspace of their own monitor already.
   for (auto &window : windowsToRender) {
-    if (window->m_workspace != pMonitor->m_activeWorkspace) {
+    if (m_collectionMode != EWindowCollectionMode::GLOBAL &&
+        window->m_workspace != pMonitor->m_activeWorkspace) {
       Debug::log(LOG, "[hyprview] Moving window '{}' from workspace {} to {}",
                  window->m_title, window->m_workspace->m_id,
                  pMonitor->m_activeWorkspace->m_id);
@@ -98,7 +110,7 @@ void CHyprView::setupWindowImages(std::vector<PHLWINDOW> &windowsToRender) {
 
   // Render all windows to framebuffers using the box positions set by placement
   // algorithm
-  for (size_t i = 0; i < images.size(); ++i) {
+  for (size_t i = 0; i < windowsToRender.size() && i < images.size(); ++i) {
     SWindowImage &image = images[i];
     auto &window = windowsToRender[i];
 
@@ -106,34 +118,46 @@ void CHyprView::setupWindowImages(std::vector<PHLWINDOW> &windowsToRender) {
     image.originalPos = window->m_realPosition->value();
     image.originalSize = window->m_realSize->value();
     image.originalWorkspace = originalWorkspaces[window];
+  }
 
-    const auto RENDERSIZE =
-        (window->m_realSize->value() * pMonitor->m_scale).floor();
-    image.fb.alloc(std::max(1.0, RENDERSIZE.x), std::max(1.0, RENDERSIZE.y),
-                   pMonitor->m_output->state->state().drmFormat);
-
-    CRegion fakeDamage{0, 0, INT16_MAX, INT16_MAX};
-
-    const auto REALPOS = window->m_realPosition->value();
-
-    // Temporarily move window to monitor position for rendering
-    window->m_realPosition->setValue(pMonitor->m_position);
-
-    g_pHyprRenderer->beginRender(pMonitor.lock(), fakeDamage,
-                                 RENDER_MODE_FULL_FAKE, nullptr, &image.fb);
+  resolveTileRules();
+  createRefreshTimer();
+  openedAt = Time::steadyNow();
 
-    if (window && window->m_isMapped) {
-      g_pHyprRenderer->renderWindow(window, pMonitor.lock(), Time::steadyNow(),
-                                    false, RENDER_PASS_MAIN, false, false);
+  // Setup scroll animation before deciding which tiles are in the viewport
+  g_pAnimationManager->createAnimation(
+      0.0f, scrollOffset,
+      g_pConfigManager->getAnimationPropertyConfig("windowsMove"),
+      AVARDAMAGE_NONE);
+  scrollOffset->setUpdateCallback(
+      [this](WP<Hyprutils::Animation::CBaseAnimatedVariable>) { damage(); });
+  scrollOffset->setValueAndWarp(0.0f);
+
+  // Only tiles in (or near) the viewport get a framebuffer, the rest are
+  // captured lazily once scrolled into view. Captures are queued and run
+  // within the frame budget, except the focused window's: the open
+  // animation starts from it, so it is captured right here.
+  const auto FOCUSED = originalFocusedWindow.lock();
+  std::optional<size_t> focusedTile;
+  for (size_t i = 0; i < images.size(); ++i) {
+    if (isTileInViewport(i)) {
+      const bool ISFOCUSED = FOCUSED && images[i].pWindow.lock() == FOCUSED;
+      if (ISFOCUSED)
+        focusedTile = i;
+      scheduleTileCapture(i, ISFOCUSED ? CJobScheduler::PRIORITY_HOVERED
+                                       : CJobScheduler::PRIORITY_VISIBLE);
+    } else if (config->windowNameEnabled) {
+      // Labels of tiles further down are ready before they are scrolled to
+      jobs.schedule(CJobScheduler::JOB_WINDOW_NAME, i,
+                    CJobScheduler::PRIORITY_CACHE_WARM,
+                    [this, i] { rasterizeWindowName(i); });
     }
-
-    g_pHyprOpenGL->m_renderData.blockScreenShader = true;
-    g_pHyprRenderer->endRender();
-
-    // Restore original position
-    window->m_realPosition->setValue(REALPOS);
   }
 
+  // Nothing outranks the focused capture, one job of the drain is it
+  if (focusedTile)
+    jobs.drain(0.0);
+
   // Setup scale animation
   Vector2D fullMonitorSize = pMonitor->m_pixelSize;
 
@@ -151,9 +175,13 @@ void CHyprView::setupWindowImages(std::vector<PHLWINDOW> &windowsToRender) {
       g_pConfigManager->getAnimationPropertyConfig("windowsMove"),
       AVARDAMAGE_NONE);
 
-  scale->setUpdateCallback(damageMonitor);
-  size->setUpdateCallback(damageMonitor);
-  pos->setUpdateCallback(damageMonitor);
+  // Bound to this instance, the variables die with it
+  const auto DAMAGE = [this](WP<Hyprutils::Animation::CBaseAnimatedVariable>) {
+    damage();
+  };
+  scale->setUpdateCallback(DAMAGE);
+  size->setUpdateCallback(DAMAGE);
+  pos->setUpdateCallback(DAMAGE);
 
   // Set to initial value and warp (no animation yet)
   scale->setValueAndWarp(0.0f);
@@ -171,6 +199,34 @@ void CHyprView::setupWindowImages(std::vector<PHLWINDOW> &windowsToRender) {
   openedID = images.empty() ? -1 : 0;
 }
 
+void CHyprView::resolveTileRules() {
+  const auto DEFAULTPOLICY = config->refreshPolicy;
+  const auto DEFAULTPROFILE = config->thumbnailProfile;
+
+  // Window rules override the global refresh policy and render profile
+  for (auto &image : images) {
+    image.refreshPolicy = DEFAULTPOLICY;
+    if (auto rule = findRuleValue(image.pWindow.lock(), "refresh"))
+      image.refreshPolicy = parseRefreshPolicy(*rule, DEFAULTPOLICY);
+
+    image.renderProfile = DEFAULTPROFILE;
+    if (auto rule = findRuleValue(image.pWindow.lock(), "profile"))
+      image.renderProfile = parseThumbnailProfile(*rule, DEFAULTPROFILE);
+  }
+}
+
+void CHyprView::createRefreshTimer() {
+  // Wakes us up when a rate limited tile becomes due for its redraw
+  refreshTimer = wl_event_loop_add_timer(
+      g_pCompositor->m_wlEventLoop,
+      [](void *data) -> int {
+        auto *self = (CHyprView *)data;
+        g_pCompositor->scheduleFrameForMonitor(self->pMonitor.lock());
+        return 0;
+      },
+      this);
+}
+
 void CHyprView::captureBackground() {
   auto monitor = pMonitor.lock();
   if (!monitor)
@@ -178,7 +234,7 @@ void CHyprView::captureBackground() {
 
   // Capture background at full monitor size to avoid recursive layers
   const auto MONITOR_SIZE = monitor->m_pixelSize;
-  const auto FORMAT = monitor->m_output->state->state().drmFormat;
+  const auto FORMAT = thumbnailFormat();
 
   // Allocate the background framebuffer at full size
   bgFramebuffer.alloc(MONITOR_SIZE.x, MONITOR_SIZE.y, FORMAT);
@@ -233,127 +289,198 @@ void CHyprView::captureBackground() {
   bgCaptured = true;
 }
 
-CHyprView::CHyprView(PHLMONITOR pMonitor_, PHLWORKSPACE startedOn_, bool swipe_,
-                     EWindowCollectionMode mode, const std::string &placement,
-                     bool explicitOn)
-    : pMonitor(pMonitor_), startedOn(startedOn_), swipe(swipe_),
-      m_collectionMode(mode), m_placement(placement), stickyOn(explicitOn) {
+void CHyprView::placeTiles(const std::vector<WindowInfo> &windowInfos,
+                           size_t first, size_t last, const ScreenInfo &area,
+                           const std::vector<size_t> *tileIds) {
+  static auto *const *PAUTOBUDGET =
+      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:auto_placement_budget_ms")
+          ->getDataStaticPtr();
 
-  // Capture the background BEFORE moving windows for the overview
-  captureBackground();
+  std::vector<WindowInfo> rangeInfos(windowInfos.begin() + first,
+                                     windowInfos.begin() + last);
+  for (size_t i = 0; i < rangeInfos.size(); ++i)
+    rangeInfos[i].id = i;
+
+  // Call the placement function based on m_placement. Identical geometry
+  // (same monitor layout and window sizes) is served from the shared cache.
+  std::vector<PlacementScore> scores;
+  PlacementResult placementResult = g_placementCache.get(
+      m_placement, rangeInfos, area, (double)**PAUTOBUDGET, &scores);
+  if (first == 0)
+    m_placementScores = std::move(scores);
+
+  // Apply placement results to images, windowInfos[i] is images[tileIds[i]]
+  // when given
+  for (size_t i = 0; i < placementResult.tiles.size() && first + i < last;
+       ++i) {
+    images[tileIds ? (*tileIds)[first + i] : first + i].box = {
+        placementResult.tiles[i].x, placementResult.tiles[i].y,
+        placementResult.tiles[i].width, placementResult.tiles[i].height};
+  }
 
-  // Block rendering until we finish moving windows to active workspace
-  // This ensures the overview layer is created AFTER workspace migration
-  blockOverviewRendering = true;
+  Debug::log(LOG,
+             "[hyprview] Placement algorithm '{}' generated {}x{} grid with {} "
+             "tiles (tiles {}-{})",
+             m_placement, placementResult.gridCols, placementResult.gridRows,
+             placementResult.tiles.size(), first, last);
+}
 
-  originalFocusedWindow = g_pCompositor->m_lastWindow;
-  userExplicitlySelected = false;
-  currentHoveredIndex = -1;
-  visualHoveredIndex = -1;
+// What type-to-filter matches a tile against: class and title, or the
+// workspace label
+std::string CHyprView::searchTextFor(size_t i) const {
+  const auto &image = images[i];
+  if (auto workspace = image.pWorkspace.lock())
+    return "Workspace " + workspace->m_name;
 
-  auto origWindow = originalFocusedWindow.lock();
-  Debug::log(LOG, "[hyprview] CHyprView(): Saved original focused window: {}",
-             (void *)origWindow.get());
+  auto window = image.pWindow.lock();
+  if (!window)
+    return "";
+  return window->m_initialClass + " " + window->m_title;
+}
 
-  static auto *const *PMARGIN =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:margin")
-          ->getDataStaticPtr();
+void CHyprView::buildSearchIndex() {
+  std::vector<std::string> texts;
+  texts.reserve(images.size());
+  for (size_t i = 0; i < images.size(); ++i)
+    texts.push_back(searchTextFor(i));
+  searchIndex.build(texts);
+  filterVisible = images.size();
+}
 
-  MARGIN = **PMARGIN;
+void CHyprView::restoreUnfilteredLayout() {
+  if (unfilteredCanvasHeight <= 0.0)
+    return;
 
-  static auto *const *PACTIVEBORDERCOL =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:active_border_color")
-          ->getDataStaticPtr();
-  static auto *const *PINACTIVEBORDERCOL =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:inactive_border_color")
-          ->getDataStaticPtr();
-  static auto *const *PBORDERWIDTH =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:border_width")
-          ->getDataStaticPtr();
-  static auto *const *PBORDERRADIUS =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:border_radius")
-          ->getDataStaticPtr();
-  static auto *const *PBGDIM =
-      (Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:bg_dim")
-          ->getDataStaticPtr();
-  static auto *const *PWORKSPACEINDICATORENABLED =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:workspace_indicator_enabled")
-          ->getDataStaticPtr();
-  static auto *const *PWORKSPACEINDICATORFONTSIZE =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:workspace_indicator_font_size")
-          ->getDataStaticPtr();
-  static auto PWORKSPACEINDICATORPOSITION_VAL = HyprlandAPI::getConfigValue(
-      PHANDLE, "plugin:hyprview:workspace_indicator_position");
-  static auto *const *PWORKSPACEINDICATORBGOPACITY =
-      (Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:workspace_indicator_bg_opacity")
-          ->getDataStaticPtr();
-  static auto *const *PWINDOWNAMEENABLED =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:window_name_enabled")
-          ->getDataStaticPtr();
-  static auto *const *PWINDOWNAMEFONTSIZE =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:window_name_font_size")
-          ->getDataStaticPtr();
-  static auto *const *PWINDOWNAMEBGOPACITY =
-      (Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:window_name_bg_opacity")
-          ->getDataStaticPtr();
-  static auto *const *PWINDOWTEXTCOLOR =
+  // Back to the layout of the open, thumbnails were kept all along
+  for (auto &image : images) {
+    image.box = image.unfilteredBox;
+    image.filteredOut = false;
+  }
+  canvasHeight = unfilteredCanvasHeight;
+  unfilteredCanvasHeight = 0.0;
+  filterVisible = images.size();
+  scrollOffset->setValueAndWarp(0.0f);
+}
+
+void CHyprView::applyFilter() {
+  static auto *const *PSCROLLPAGESIZE =
       (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:hyprview:window_text_color")
+          PHANDLE, "plugin:hyprview:scroll_page_size")
           ->getDataStaticPtr();
 
-  ACTIVE_BORDER_COLOR = **PACTIVEBORDERCOL;
-  INACTIVE_BORDER_COLOR = **PINACTIVEBORDERCOL;
-  BORDER_WIDTH = **PBORDERWIDTH;
-  BORDER_RADIUS = **PBORDERRADIUS;
-  BG_DIM = **PBGDIM;
-  WORKSPACE_INDICATOR_ENABLED = **PWORKSPACEINDICATORENABLED != 0;
-  WORKSPACE_INDICATOR_FONT_SIZE = **PWORKSPACEINDICATORFONTSIZE;
-  WORKSPACE_INDICATOR_BG_OPACITY = **PWORKSPACEINDICATORBGOPACITY;
-  WORKSPACE_INDICATOR_POSITION = "";
-  WINDOW_NAME_ENABLED = **PWINDOWNAMEENABLED != 0;
-  WINDOW_NAME_FONT_SIZE = **PWINDOWNAMEFONTSIZE;
-  WINDOW_NAME_BG_OPACITY = **PWINDOWNAMEBGOPACITY;
-  WINDOW_TEXT_COLOR = **PWINDOWTEXTCOLOR;
-
-  try {
-    if (PWORKSPACEINDICATORPOSITION_VAL) {
-      if (auto strPtr =
-              (Hyprlang::STRING const *)
-                  PWORKSPACEINDICATORPOSITION_VAL->getDataStaticPtr()) {
-        if (*strPtr) {
-          WORKSPACE_INDICATOR_POSITION = *strPtr;
-        }
-      }
+  // The query label is rasterized before the next frame is drawn
+  jobs.schedule(CJobScheduler::JOB_FILTER_LABEL, 0,
+                CJobScheduler::PRIORITY_HOVERED, [this] {
+                  const std::string TEXT =
+                      filterQuery + "  (" + std::to_string(filterVisible) +
+                      "/" + std::to_string(images.size()) + ")";
+                  if (filterQuery.empty() || TEXT == filterTextureKey)
+                    return;
+                  filterTexture = g_pHyprOpenGL->renderText(
+                      TEXT, config->windowTextColor,
+                      config->windowNameFontSize, false, "sans-serif");
+                  filterTextureKey = TEXT;
+                });
+
+  const bool WASFILTERED = unfilteredCanvasHeight > 0.0;
+  if (filterQuery.empty()) {
+    if (!WASFILTERED)
+      return;
+    restoreUnfilteredLayout();
+  } else {
+    if (!WASFILTERED) {
+      for (auto &image : images)
+        image.unfilteredBox = image.box;
+      unfilteredCanvasHeight = canvasHeight;
+    }
+
+    const auto &MATCHES = searchIndex.search(filterQuery);
+
+    // Same survivors (a keystroke that ruled nothing out, a title change):
+    // the layout stays, only the label changes
+    const bool UNCHANGED =
+        WASFILTERED && MATCHES.size() == filterVisible &&
+        std::ranges::all_of(MATCHES,
+                            [&](size_t id) { return !images[id].filteredOut; });
+    if (UNCHANGED) {
+      damage();
+      return;
+    }
+
+    std::vector<WindowInfo> windowInfos;
+    windowInfos.reserve(MATCHES.size());
+    for (auto &image : images)
+      image.filteredOut = true;
+    for (size_t i = 0; i < MATCHES.size(); ++i) {
+      auto &image = images[MATCHES[i]];
+      image.filteredOut = false;
+      windowInfos.push_back({i, image.originalSize.x, image.originalSize.y});
+    }
+    filterVisible = MATCHES.size();
+
+    scrollOffset->setValueAndWarp(0.0f);
+
+    // Only the survivors are placed, paged like the open
+    const double PAGEHEIGHT = pMonitor->m_pixelSize.y;
+    const size_t PAGESIZE =
+        **PSCROLLPAGESIZE > 0 ? (size_t)**PSCROLLPAGESIZE : windowInfos.size();
+    const size_t PAGECOUNT =
+        PAGESIZE > 0 ? std::max<size_t>(1, (windowInfos.size() + PAGESIZE - 1) /
+                                               PAGESIZE)
+                     : 1;
+    canvasHeight = PAGEHEIGHT * PAGECOUNT;
+
+    for (size_t page = 0; page < PAGECOUNT && !windowInfos.empty(); ++page) {
+      ScreenInfo pageScreen = filterArea;
+      pageScreen.offsetY += PAGEHEIGHT * page;
+      placeTiles(windowInfos, page * PAGESIZE,
+                 std::min(windowInfos.size(), (page + 1) * PAGESIZE),
+                 pageScreen, &MATCHES);
     }
-  } catch (...) {
-    // Keep default on any exception
   }
 
-  std::vector<PHLWINDOW> windowsToRender;
+  // Survivors keep their thumbnails, only tiles without one (never on screen
+  // before, or evicted) are captured
+  for (size_t i = 0; i < images.size(); ++i) {
+    if (!hasThumbnail(images[i]) && isTileInViewport(i))
+      scheduleTileCapture(i, CJobScheduler::PRIORITY_VISIBLE);
+  }
 
-  PHLWORKSPACE activeWorkspace = pMonitor->m_activeWorkspace;
+  // The first match is what Enter selects, without a query the pointer
+  // decides again
+  int hovered = getWindowIndexFromMousePos(lastMousePosLocal);
+  if (!filterQuery.empty()) {
+    const auto FIRST = std::ranges::find_if(
+        images, [](const SWindowImage &image) { return !image.filteredOut; });
+    hovered = FIRST != images.end() ? (int)(FIRST - images.begin()) : -1;
+  }
+  updateHoverState(hovered);
 
-  if (!activeWorkspace)
-    return;
+  damage();
+  Debug::log(LOG, "[hyprview] Filter '{}': {}/{} tiles ({} texts compared)",
+             filterQuery, filterVisible, images.size(),
+             searchIndex.lastCompared());
+}
 
-  Debug::log(LOG,
-             "[hyprview] CHyprView(): Collecting windows for monitor '{}', "
-             "workspace ID {}, mode={}",
-             pMonitor->m_description, activeWorkspace->m_id,
-             (int)m_collectionMode);
+// Workspace thumbnail mode: one tile per (non-special) workspace on the
+// monitor, rendered as a whole - no windows are collected or migrated
+std::vector<PHLWORKSPACE> CHyprView::collectWorkspaces() const {
+  std::vector<PHLWORKSPACE> workspacesToRender;
+  for (auto &ws : g_pCompositor->getWorkspacesCopy()) {
+    if (ws && ws->m_monitor.lock() == pMonitor.lock() &&
+        !ws->m_isSpecialWorkspace)
+      workspacesToRender.push_back(ws);
+  }
+  std::sort(workspacesToRender.begin(), workspacesToRender.end(),
+            [](const PHLWORKSPACE &a, const PHLWORKSPACE &b) {
+              return a->m_id < b->m_id;
+            });
+  return workspacesToRender;
+}
 
+std::vector<PHLWINDOW>
+CHyprView::collectWindows(const PHLWORKSPACE &activeWorkspace) const {
   // Lambda to check if window should be included based on collection mode
   auto shouldIncludeWindow = [&](PHLWINDOW w) -> bool {
     auto windowWorkspace = w->m_workspace;
@@ -361,7 +488,10 @@ CHyprView::CHyprView(PHLMONITOR pMonitor_, PHLWORKSPACE startedOn_, bool swipe_,
       return false;
 
     auto windowMonitor = w->m_monitor.lock();
-    if (!windowMonitor || windowMonitor != pMonitor.lock())
+    if (!windowMonitor)
+      return false;
+    if (m_collectionMode != EWindowCollectionMode::GLOBAL &&
+        windowMonitor != pMonitor.lock())
       return false;
 
     switch (m_collectionMode) {
@@ -381,10 +511,19 @@ CHyprView::CHyprView(PHLMONITOR pMonitor_, PHLWORKSPACE startedOn_, bool swipe_,
     case EWindowCollectionMode::ALL_WITH_SPECIAL:
       // All workspaces on monitor including special
       return true;
+
+    case EWindowCollectionMode::WORKSPACES:
+      // Tiles are whole workspaces, not windows
+      return false;
+
+    case EWindowCollectionMode::GLOBAL:
+      // What every monitor shows right now, nothing has to be migrated
+      return windowWorkspace == windowMonitor->m_activeWorkspace;
     }
     return false;
   };
 
+  std::vector<PHLWINDOW> windowsToRender;
   for (auto &w : g_pCompositor->m_windows) {
     if (!w->m_isMapped || w->isHidden())
       continue;
@@ -423,6 +562,54 @@ CHyprView::CHyprView(PHLMONITOR pMonitor_, PHLWORKSPACE startedOn_, bool swipe_,
         return a->m_realPosition->value().y < b->m_realPosition->value().y;
       });
 
+  return windowsToRender;
+}
+
+CHyprView::CHyprView(PHLMONITOR pMonitor_, PHLWORKSPACE startedOn_, bool swipe_,
+                     EWindowCollectionMode mode, const std::string &placement,
+                     bool explicitOn, bool deferBackground)
+    : pMonitor(pMonitor_), startedOn(startedOn_), swipe(swipe_),
+      m_collectionMode(mode), m_placement(placement), stickyOn(explicitOn) {
+
+  // Shared with the other instances, replaced on config reload
+  config = hyprViewConfig();
+
+  // Capture the background BEFORE moving windows for the overview. A batched
+  // open captures it in startOpen(), with the migrated windows hidden like
+  // every other window on the monitor.
+  if (!deferBackground)
+    captureBackground();
+
+  // Block rendering until we finish moving windows to active workspace
+  // This ensures the overview layer is created AFTER workspace migration
+  blockOverviewRendering = true;
+
+  originalFocusedWindow = g_pCompositor->m_lastWindow;
+  userExplicitlySelected = false;
+  currentHoveredIndex = -1;
+  visualHoveredIndex = -1;
+
+  auto origWindow = originalFocusedWindow.lock();
+  Debug::log(LOG, "[hyprview] CHyprView(): Saved original focused window: {}",
+             (void *)origWindow.get());
+
+  PHLWORKSPACE activeWorkspace = pMonitor->m_activeWorkspace;
+
+  if (!activeWorkspace)
+    return;
+
+  Debug::log(LOG,
+             "[hyprview] CHyprView(): Collecting windows for monitor '{}', "
+             "workspace ID {}, mode={}",
+             pMonitor->m_description, activeWorkspace->m_id,
+             (int)m_collectionMode);
+
+  std::vector<PHLWORKSPACE> workspacesToRender;
+  if (m_collectionMode == EWindowCollectionMode::WORKSPACES)
+    workspacesToRender = collectWorkspaces();
+
+  std::vector<PHLWINDOW> windowsToRender = collectWindows(activeWorkspace);
+
   // Prepare input for pure placement algorithm
   std::vector<WindowInfo> windowInfos;
   windowInfos.reserve(windowsToRender.size());
@@ -435,6 +622,11 @@ CHyprView::CHyprView(PHLMONITOR pMonitor_, PHLWORKSPACE startedOn_, bool swipe_,
     });
   }
 
+  // Workspace tiles all have the monitor's shape
+  for (size_t i = 0; i < workspacesToRender.size(); ++i) {
+    windowInfos.push_back({i, pMonitor->m_size.x, pMonitor->m_size.y});
+  }
+
   // Prepare screen info (available area after reserved regions)
   Vector2D reservedTopLeft = pMonitor->m_reservedTopLeft;
   Vector2D reservedBottomRight = pMonitor->m_reservedBottomRight;
@@ -442,10 +634,10 @@ CHyprView::CHyprView(PHLMONITOR pMonitor_, PHLWORKSPACE startedOn_, bool swipe_,
 
   // Calculate extra bottom margin needed for window names if enabled
   double bottomMarginAdjustment = 0.0;
-  if (WINDOW_NAME_ENABLED) {
+  if (config->windowNameEnabled) {
     // Reserve space for text: font size + padding + background padding
     // Approximate height: font_size * 1.5 (for rendering) + top/bottom padding (8px total)
-    bottomMarginAdjustment = WINDOW_NAME_FONT_SIZE * 1.5 + 8.0;
+    bottomMarginAdjustment = config->windowNameFontSize * 1.5 + 8.0;
   }
 
   ScreenInfo screenInfo = {
@@ -453,42 +645,128 @@ CHyprView::CHyprView(PHLMONITOR pMonitor_, PHLWORKSPACE startedOn_, bool swipe_,
       fullMonitorSize.y - reservedTopLeft.y - reservedBottomRight.y - bottomMarginAdjustment, // height (adjusted for window names)
       reservedTopLeft.x,                                                                      // offsetX
       reservedTopLeft.y,                                                                      // offsetY
-      (double)MARGIN                                                                          // margin
+      (double)config->margin                                                                  // margin
   };
 
-  // Call the placement function based on m_placement
-  PlacementResult placementResult;
-  if (m_placement == "spiral") {
-    placementResult = spiralPlacement(windowInfos, screenInfo);
-  } else if (m_placement == "flow") {
-    placementResult = flowPlacement(windowInfos, screenInfo);
-  } else if (m_placement == "adaptive") {
-    placementResult = adaptivePlacement(windowInfos, screenInfo);
-  } else if (m_placement == "wide") {
-    placementResult = widePlacement(windowInfos, screenInfo);
-  } else if (m_placement == "scale") {
-    placementResult = scalePlacement(windowInfos, screenInfo);
+  static auto *const *PSCROLLPAGESIZE =
+      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:scroll_page_size")
+          ->getDataStaticPtr();
+  static auto *const *PGROUPWORKSPACES =
+      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:group_workspaces")
+          ->getDataStaticPtr();
+
+  images.resize(windowInfos.size());
+  canvasHeight = fullMonitorSize.y;
+  filterArea = screenInfo;
+
+  const bool GROUPED =
+      **PGROUPWORKSPACES != 0 &&
+      (m_collectionMode == EWindowCollectionMode::ALL_WORKSPACES ||
+       m_collectionMode == EWindowCollectionMode::ALL_WITH_SPECIAL);
+  const bool GLOBAL = m_collectionMode == EWindowCollectionMode::GLOBAL;
+
+  if (GROUPED || GLOBAL) {
+    // One section per workspace. Windows are already sorted so each
+    // workspace is a contiguous run. In global mode that is one visible
+    // workspace, and so one section, per monitor.
+    std::vector<size_t> groupSizes;
+    for (size_t i = 0; i < windowsToRender.size(); ++i) {
+      if (i == 0 ||
+          windowsToRender[i]->m_workspace != windowsToRender[i - 1]->m_workspace) {
+        sections.push_back({windowsToRender[i]->m_workspace, {}, i, 0, nullptr});
+        if (GLOBAL)
+          sections.back().monitor = windowsToRender[i]->m_monitor;
+        groupSizes.push_back(0);
+      }
+      sections.back().tileCount++;
+      groupSizes.back()++;
+    }
+
+    // Sections get the full available area, each one reserves room for its
+    // own header and window names
+    ScreenInfo sectionScreen = screenInfo;
+    sectionScreen.height += bottomMarginAdjustment;
+    const double HEADERHEIGHT = config->windowNameFontSize * 1.5 + 8.0;
+    std::vector<SectionInfo> sectionInfos;
+    if (GLOBAL) {
+      // Monitors without windows still take part, so the others keep their
+      // place in the arrangement
+      std::vector<PHLMONITOR> arranged;
+      std::vector<TileRect> rects;
+      for (auto &monitor : g_pCompositor->m_monitors) {
+        if (!monitor->m_enabled)
+          continue;
+        arranged.push_back(monitor);
+        rects.push_back({monitor->m_position.x, monitor->m_position.y,
+                         monitor->m_size.x, monitor->m_size.y});
+      }
+
+      const auto ARRANGED =
+          arrangedSectionLayout(rects, sectionScreen, HEADERHEIGHT);
+      for (const auto &section : sections) {
+        const auto IT = std::ranges::find(arranged, section.monitor.lock());
+        sectionInfos.push_back(IT != arranged.end() &&
+                                       ARRANGED.size() == arranged.size()
+                                   ? ARRANGED[IT - arranged.begin()]
+                                   : SectionInfo{});
+      }
+    } else {
+      sectionInfos = sectionLayout(groupSizes, sectionScreen, HEADERHEIGHT);
+    }
+
+    for (size_t i = 0; i < sections.size(); ++i) {
+      auto &section = sections[i];
+      const auto &header = sectionInfos[i].header;
+      section.header = {header.x, header.y, header.width, header.height};
+
+      ScreenInfo area = sectionInfos[i].area;
+      area.height = std::max(0.0, area.height - bottomMarginAdjustment);
+
+      // Each section is cached on its own, so a change in one workspace only
+      // recomputes that section
+      placeTiles(windowInfos, section.firstTile,
+                 section.firstTile + section.tileCount, area);
+    }
   } else {
-    // Default to grid placement
-    placementResult = gridPlacement(windowInfos, screenInfo);
+    // With more windows than fit on a page the overview becomes a scrollable
+    // virtual canvas: each page is laid out one monitor height below the last
+    const size_t PAGESIZE =
+        **PSCROLLPAGESIZE > 0 ? (size_t)**PSCROLLPAGESIZE : windowInfos.size();
+    const size_t PAGECOUNT =
+        PAGESIZE > 0 ? std::max<size_t>(1, (windowInfos.size() + PAGESIZE - 1) /
+                                               PAGESIZE)
+                     : 1;
+    canvasHeight = fullMonitorSize.y * PAGECOUNT;
+
+    for (size_t page = 0; page < PAGECOUNT; ++page) {
+      ScreenInfo pageScreen = screenInfo;
+      pageScreen.offsetY += fullMonitorSize.y * page;
+
+      placeTiles(windowInfos, page * PAGESIZE,
+                 std::min(windowInfos.size(), (page + 1) * PAGESIZE),
+                 pageScreen);
+    }
   }
 
-  // Apply placement results to images
-  images.resize(placementResult.tiles.size());
-  for (size_t i = 0; i < placementResult.tiles.size(); ++i) {
-    images[i].box = {placementResult.tiles[i].x, placementResult.tiles[i].y,
-                     placementResult.tiles[i].width,
-                     placementResult.tiles[i].height};
+  for (const auto &score : m_placementScores) {
+    Debug::log(LOG,
+               "[hyprview] auto placement candidate '{}': score={:.3f} "
+               "utilization={:.3f} minScale={:.3f} {:.2f}ms{}",
+               score.name, score.score, score.utilization, score.minScale,
+               score.elapsedMs, score.completed ? "" : " (over budget)");
   }
 
-  Debug::log(
-      LOG,
-      "[hyprview] Placement algorithm '{}' generated {}x{} grid with {} tiles",
-      m_placement, placementResult.gridCols, placementResult.gridRows,
-      placementResult.tiles.size());
+  for (size_t i = 0; i < workspacesToRender.size(); ++i) {
+    images[i].pWorkspace = workspacesToRender[i];
+    images[i].originalPos = pMonitor->m_position;
+    images[i].originalSize = pMonitor->m_size;
+  }
 
   // Now call common setup to handle window rendering
   setupWindowImages(windowsToRender);
+  buildSearchIndex();
 
   g_pHyprRenderer->m_bBlockSurfaceFeedback = false;
 
@@ -497,353 +775,1482 @@ CHyprView::CHyprView(PHLMONITOR pMonitor_, PHLWORKSPACE startedOn_, bool swipe_,
   lastMousePosLocal =
       g_pInputManager->getMouseCoordsInternal() - pMonitor->m_position;
 
-  auto onCursorMove = [this](void *self, SCallbackInfo &info, std::any param) {
-    if (closing)
-      return;
+  // NOW unblock rendering - workspace migration is complete
+  // The overview layer will be created on the next render pass
+  blockOverviewRendering = false;
+  Debug::log(
+      LOG, "[hyprview] CHyprView(): Constructor complete, unblocked rendering");
+}
 
-    // Check if mouse is actually on this monitor BEFORE cancelling
-    Vector2D globalMousePos = g_pInputManager->getMouseCoordsInternal();
-    Vector2D monitorPos = pMonitor->m_position;
-    Vector2D fullMonitorSize = pMonitor->m_pixelSize;
+void CHyprView::onPointerMove(const Vector2D &localPos, SCallbackInfo &info) {
+  if (closing)
+    return;
 
-    bool mouseOnThisMonitor =
-        (globalMousePos.x >= monitorPos.x &&
-         globalMousePos.x < monitorPos.x + fullMonitorSize.x &&
-         globalMousePos.y >= monitorPos.y &&
-         globalMousePos.y < monitorPos.y + fullMonitorSize.y);
+  lastMousePosLocal = localPos;
+  pointerEvents++;
 
-    if (!mouseOnThisMonitor) {
-      return; // Mouse is on a different monitor - don't cancel event
-    }
+  // A hardware cursor moves without a frame, ask for one to hit test in
+  if (!pointerMotionPending) {
+    pointerMotionPending = true;
+    g_pCompositor->scheduleFrameForMonitor(pMonitor.lock());
+  }
+
+  // Cancel move events in overview mode
+  info.cancelled = true;
+}
 
-    lastMousePosLocal = globalMousePos - monitorPos;
+void CHyprView::flushPointerMotion() {
+  if (!pointerMotionPending)
+    return;
 
-    if (!images.empty()) {
-      int tileIndex = getWindowIndexFromMousePos(lastMousePosLocal);
-      updateHoverState(tileIndex);
-    }
+  pointerMotionPending = false;
+  if (images.empty())
+    return;
+
+  pointerHitTests++;
+  updateHoverState(getWindowIndexFromMousePos(lastMousePosLocal));
+}
+
+void CHyprView::onPointerButton(const Vector2D &localPos,
+                                SCallbackInfo &info) {
+  if (closing)
+    return;
 
-    // Cancel move events in overview mode
+  // A click before the next frame acts on where the pointer is now
+  flushPointerMotion();
+
+  // If explicitly turned on, project click to real window
+  if (stickyOn) {
     info.cancelled = true;
-  };
 
-  auto onCursorSelect = [this](void *self, SCallbackInfo &info,
-                               std::any param) {
-    if (closing)
-      return;
+    int tileIndex = getWindowIndexFromMousePos(localPos);
 
-    // Check if mouse is on this monitor BEFORE cancelling
-    Vector2D globalMousePos = g_pInputManager->getMouseCoordsInternal();
-    Vector2D monitorPos = pMonitor->m_position;
-    Vector2D fullMonitorSize = pMonitor->m_pixelSize;
+    if (tileIndex >= 0 && tileIndex < (int)images.size()) {
+      auto window = images[tileIndex].pWindow.lock();
+      if (window && window->m_isMapped) {
+        // Focus the window first
+        g_pCompositor->focusWindow(window);
 
-    bool mouseOnThisMonitor =
-        (globalMousePos.x >= monitorPos.x &&
-         globalMousePos.x < monitorPos.x + fullMonitorSize.x &&
-         globalMousePos.y >= monitorPos.y &&
-         globalMousePos.y < monitorPos.y + fullMonitorSize.y);
+        // Calculate mouse position relative to tile
+        const CBox &tileBox = images[tileIndex].box;
+        const Vector2D canvasMousePos = toCanvas(localPos);
+        Vector2D mousePosInTile = {canvasMousePos.x - tileBox.x,
+                                   canvasMousePos.y - tileBox.y};
 
-    if (!mouseOnThisMonitor) {
-      return; // Mouse is on a different monitor - don't cancel event
-    }
+        // Calculate scale factor from tile to real window
+        Vector2D realWindowSize = window->m_realSize->value();
+        Vector2D scaleFactors = {realWindowSize.x / tileBox.width,
+                                 realWindowSize.y / tileBox.height};
 
-    // If explicitly turned on, project click to real window
-    if (stickyOn) {
-      info.cancelled = true;
+        // Project to real window coordinates
+        Vector2D projectedPos = {mousePosInTile.x * scaleFactors.x,
+                                 mousePosInTile.y * scaleFactors.y};
 
-      Vector2D localMousePos = globalMousePos - monitorPos;
-      int tileIndex = getWindowIndexFromMousePos(localMousePos);
+        // Warp cursor to projected position on real window
+        Vector2D realWindowPos = window->m_realPosition->value();
+        Vector2D targetGlobalPos = realWindowPos + projectedPos;
 
-      if (tileIndex >= 0 && tileIndex < (int)images.size()) {
-        auto window = images[tileIndex].pWindow.lock();
-        if (window && window->m_isMapped) {
-          // Focus the window first
-          g_pCompositor->focusWindow(window);
+        // Use InputManager to move mouse to projected position
+        g_pInputManager->mouseMoveUnified(0, true, true, targetGlobalPos);
+      }
+    }
 
-          // Calculate mouse position relative to tile
-          const CBox &tileBox = images[tileIndex].box;
-          Vector2D mousePosInTile = {localMousePos.x - tileBox.x,
-                                     localMousePos.y - tileBox.y};
+    return;
+  }
 
-          // Calculate scale factor from tile to real window
-          Vector2D realWindowSize = window->m_realSize->value();
-          Vector2D scaleFactors = {realWindowSize.x / tileBox.width,
-                                   realWindowSize.y / tileBox.height};
+  // Normal mode: cancel click, select window, and close ALL overviews except
+  // forced ones
+  info.cancelled = true;
+  selectHoveredWindow();
 
-          // Project to real window coordinates
-          Vector2D projectedPos = {mousePosInTile.x * scaleFactors.x,
-                                   mousePosInTile.y * scaleFactors.y};
+  // Close all overview instances except those with stickyOn=true
+  for (auto &[monitor, instance] : g_pHyprViewInstances) {
+    if (instance && !instance->stickyOn) {
+      instance->close();
+    }
+  }
+}
 
-          // Warp cursor to projected position on real window
-          Vector2D realWindowPos = window->m_realPosition->value();
-          Vector2D targetGlobalPos = realWindowPos + projectedPos;
+void CHyprView::onPointerAxis(const Vector2D &localPos, SCallbackInfo &info,
+                              std::any param) {
+  if (closing)
+    return;
 
-          // Use InputManager to move mouse to projected position
-          g_pInputManager->mouseMoveUnified(0, true, true, targetGlobalPos);
-        }
+  // If explicitly on, ensure the window under the cursor is focused for
+  // scroll
+  if (stickyOn) {
+    int tileIndex = getWindowIndexFromMousePos(localPos);
+
+    if (tileIndex >= 0 && tileIndex < (int)images.size()) {
+      auto window = images[tileIndex].pWindow.lock();
+      if (window && window->m_isMapped) {
+        // Make sure this window is focused so scroll events go to it
+        g_pCompositor->focusWindow(window);
+        // Don't cancel - let scroll event pass through to the focused window
+        return;
       }
+    }
+  }
 
-      return;
+  // A virtual canvas taller than the monitor scrolls with the wheel or
+  // touchpad instead of passing the event on
+  if (canvasHeight > pMonitor->m_pixelSize.y) {
+    auto EMAP = std::any_cast<std::unordered_map<std::string, std::any>>(param);
+    auto e = std::any_cast<IPointer::SAxisEvent>(EMAP["event"]);
+    if (e.axis == WL_POINTER_AXIS_VERTICAL_SCROLL) {
+      scrollBy(e.delta * SCROLL_SPEED);
+      info.cancelled = true;
     }
+    return;
+  }
+
+  // In normal (non-explicit) overview mode, don't do anything special with
+  // scroll The focused window from hover will receive it
+}
+
+void CHyprView::onKey(SCallbackInfo &info, std::any param) {
+  // Sticky overviews leave the keyboard to the windows
+  if (closing || stickyOn || images.empty())
+    return;
+
+  auto EMAP = std::any_cast<std::unordered_map<std::string, std::any>>(param);
+  const auto EVENT = std::any_cast<IKeyboard::SKeyEvent>(EMAP["event"]);
+  const auto KEYBOARD = std::any_cast<SP<IKeyboard>>(EMAP["keyboard"]);
+  if (EVENT.state != WL_KEYBOARD_KEY_STATE_PRESSED || !KEYBOARD)
+    return;
+
+  // Binds with modifiers keep working
+  if (KEYBOARD->getModifiers() &
+      (HL_MODIFIER_CTRL | HL_MODIFIER_ALT | HL_MODIFIER_META))
+    return;
+
+  if (EVENT.keycode == KEY_ENTER || EVENT.keycode == KEY_KPENTER) {
+    if (filterQuery.empty())
+      return;
 
-    // Normal mode: cancel click, select window, and close ALL overviews except
-    // forced ones
     info.cancelled = true;
-    selectHoveredWindow();
+    if (currentHoveredIndex < 0)
+      return;
 
-    // Close all overview instances except those with stickyOn=true
+    // Same as a click on the first match
+    selectHoveredWindow();
     for (auto &[monitor, instance] : g_pHyprViewInstances) {
-      if (instance && !instance->stickyOn) {
+      if (instance && !instance->stickyOn)
         instance->close();
-      }
     }
-  };
+    return;
+  }
 
-  auto onMouseAxis = [this](void *self, SCallbackInfo &info, std::any param) {
-    if (closing)
+  if (EVENT.keycode == KEY_ESC || EVENT.keycode == KEY_BACKSPACE) {
+    // Without a query these are left to the binds
+    if (filterQuery.empty())
       return;
 
-    // Check if mouse is on this monitor
-    Vector2D globalMousePos = g_pInputManager->getMouseCoordsInternal();
-    Vector2D monitorPos = pMonitor->m_position;
-    Vector2D fullMonitorSize = pMonitor->m_pixelSize;
-
-    bool mouseOnThisMonitor =
-        (globalMousePos.x >= monitorPos.x &&
-         globalMousePos.x < monitorPos.x + fullMonitorSize.x &&
-         globalMousePos.y >= monitorPos.y &&
-         globalMousePos.y < monitorPos.y + fullMonitorSize.y);
-
-    if (!mouseOnThisMonitor) {
-      return; // Mouse is on a different monitor - don't interfere
-    }
-
-    // If explicitly on, ensure the window under the cursor is focused for
-    // scroll
-    if (stickyOn) {
-      Vector2D localMousePos = globalMousePos - monitorPos;
-      int tileIndex = getWindowIndexFromMousePos(localMousePos);
-
-      if (tileIndex >= 0 && tileIndex < (int)images.size()) {
-        auto window = images[tileIndex].pWindow.lock();
-        if (window && window->m_isMapped) {
-          // Make sure this window is focused so scroll events go to it
-          g_pCompositor->focusWindow(window);
-          // Don't cancel - let scroll event pass through to the focused window
-          return;
-        }
-      }
+    if (EVENT.keycode == KEY_ESC) {
+      filterQuery.clear();
+    } else {
+      // Drop one UTF-8 character
+      size_t length = filterQuery.size() - 1;
+      while (length > 0 && (filterQuery[length] & 0xC0) == 0x80)
+        length--;
+      filterQuery.resize(length);
     }
+  } else {
+    if (!KEYBOARD->m_xkbState)
+      return;
 
-    // In normal (non-explicit) overview mode, don't do anything special with
-    // scroll The focused window from hover will receive it
-  };
-
-  mouseMoveHook = g_pHookSystem->hookDynamic("mouseMove", onCursorMove);
-  touchMoveHook = g_pHookSystem->hookDynamic("touchMove", onCursorMove);
+    char text[8] = {};
+    const int LENGTH = xkb_state_key_get_utf8(
+        KEYBOARD->m_xkbState, EVENT.keycode + 8, text, sizeof(text));
+    // Tab, arrows and other keys without a printable character
+    if (LENGTH <= 0 || (unsigned char)text[0] < 0x20 || text[0] == 0x7f)
+      return;
 
-  mouseButtonHook = g_pHookSystem->hookDynamic("mouseButton", onCursorSelect);
-  mouseAxisHook = g_pHookSystem->hookDynamic("mouseAxis", onMouseAxis);
-  touchDownHook = g_pHookSystem->hookDynamic("touchDown", onCursorSelect);
+    filterQuery += text;
+  }
 
-  // NOW unblock rendering - workspace migration is complete
-  // The overview layer will be created on the next render pass
-  blockOverviewRendering = false;
-  Debug::log(
-      LOG, "[hyprview] CHyprView(): Constructor complete, unblocked rendering");
+  info.cancelled = true;
+  applyFilter();
 }
 
-void CHyprView::selectHoveredWindow() {
+void CHyprView::onWindowTitleChanged(const PHLWINDOW &window) {
+  for (size_t i = 0; i < images.size(); ++i) {
+    if (images[i].pWindow.lock() != window)
+      continue;
+
+    searchIndex.update(i, searchTextFor(i));
+    if (!filterQuery.empty() && !closing)
+      applyFilter();
+    return;
+  }
+}
+
+void CHyprView::selectHoveredWindow() {
   if (closing)
     return;
 
-  // Use the currently tracked hovered index for consistency
-  closeOnID = currentHoveredIndex;
+  // Use the currently tracked hovered index for consistency
+  closeOnID = currentHoveredIndex;
+
+  // Safety validation - ensure we have a valid window to select
+  if (closeOnID < 0 || closeOnID >= (int)images.size()) {
+    Debug::log(WARN,
+               "[hyprview] selectHoveredWindow(): Invalid currentHoveredIndex "
+               "{}, recalculating from mouse position",
+               closeOnID);
+
+    // Fallback: recalculate from current mouse position
+    closeOnID = getWindowIndexFromMousePos(lastMousePosLocal);
+
+    // Final fallback: use bounds-clamped value
+    if (closeOnID < 0 || closeOnID >= (int)images.size()) {
+      closeOnID = std::max(0, std::min((int)images.size() - 1, 0));
+    }
+  }
+
+  // Verify the selected window is valid
+  if (closeOnID >= 0 && closeOnID < (int)images.size()) {
+    auto selectedWindow = images[closeOnID].pWindow.lock();
+    if (!selectedWindow || !selectedWindow->m_isMapped) {
+      Debug::log(WARN,
+                 "[hyprview] selectHoveredWindow(): Selected window at index "
+                 "{} is invalid",
+                 closeOnID);
+    }
+  }
+
+  userExplicitlySelected = true;
+
+  Debug::log(LOG,
+             "[hyprview] selectHoveredWindow(): User explicitly selected "
+             "window at index {} (from currentHoveredIndex {})",
+             closeOnID, currentHoveredIndex);
+}
+
+double CHyprView::captureScale(const SWindowImage &image,
+                               const Vector2D &source,
+                               bool fullResolution) const {
+  static auto *const *PLOD =
+      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:thumbnail_lod")
+          ->getDataStaticPtr();
+
+  // Low level of detail: just big enough for the tile. Workspace thumbnails
+  // are always captured that way.
+  double scale = 1.0;
+  if (!fullResolution && (**PLOD || image.pWorkspace) && source.x > 0 &&
+      source.y > 0) {
+    scale = std::min(
+        {1.0, image.box.width / source.x, image.box.height / source.y});
+  }
+
+  // Never larger than the monitor, also at full resolution: a window bigger
+  // than it (huge floating canvases, oversized XWayland windows) is fit in
+  // and only ever shown shrunk into a tile anyway
+  if (source.x > 0 && source.y > 0)
+    scale = std::min({scale, pMonitor->m_pixelSize.x / source.x,
+                      pMonitor->m_pixelSize.y / source.y});
+
+  // Captured smaller still when the quality controller is degrading or the
+  // VRAM budget is exceeded
+  if (!fullResolution)
+    scale *= thumbnailVramScale;
+  return scale * quality.settings().resolutionScale;
+}
+
+CHyprView::SCaptureTarget
+CHyprView::prepareCaptureTarget(SWindowImage &image, const Vector2D &size,
+                                bool fullResolution) {
+  static auto *const *PATLAS =
+      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:thumbnail_atlas")
+          ->getDataStaticPtr();
+
+  // Thumbnails share atlas pages, the full resolution capture never does
+  if (**PATLAS && !fullResolution && ensureAtlasSlot(image, size)) {
+    const auto &SLOT = *image.atlasSlot;
+    // The caller renders into it right away
+    image.atlasPending = false;
+    return {atlasPages[SLOT.page].get(),
+            CBox{(double)SLOT.x, (double)SLOT.y, (double)SLOT.width,
+                 (double)SLOT.height},
+            true};
+  }
+
+  // Own framebuffer, also when the atlas is full
+  CFramebuffer &fb = fullResolution ? hiResFb : image.fb;
+  if (fb.m_size.x != size.x || fb.m_size.y != size.y) {
+    fb.release();
+    fb.alloc(size.x, size.y, thumbnailFormat());
+  }
+
+  return {&fb, CBox{{0, 0}, size}, false};
+}
+
+bool CHyprView::ensureAtlasSlot(SWindowImage &image, const Vector2D &size) {
+  const int WIDTH = (int)size.x;
+  const int HEIGHT = (int)size.y;
+  if (image.atlasSlot && image.atlasSlot->width == WIDTH &&
+      image.atlasSlot->height == HEIGHT)
+    return true;
+
+  if (!atlasPacker)
+    atlasPacker.emplace((int)pMonitor->m_pixelSize.x,
+                        (int)pMonitor->m_pixelSize.y, ATLAS_MAX_PAGES);
+
+  // Resized: give the old slot back first
+  if (image.atlasSlot) {
+    atlasPacker->release(*image.atlasSlot);
+    image.atlasSlot.reset();
+  }
+
+  auto slot = atlasPacker->allocate(WIDTH, HEIGHT);
+
+  // Out of space but enough of it is fragmented: pack everything again
+  if (!slot && atlasPacker->freeArea() >= 2L * WIDTH * HEIGHT) {
+    repackAtlas();
+    slot = atlasPacker->allocate(WIDTH, HEIGHT);
+  }
+
+  if (!slot)
+    return false;
+
+  while (atlasPages.size() < atlasPacker->pageCount()) {
+    auto page = makeUnique<CFramebuffer>();
+    page->alloc(pMonitor->m_pixelSize.x, pMonitor->m_pixelSize.y,
+                thumbnailFormat());
+    atlasPages.emplace_back(std::move(page));
+  }
+  if (atlasPages.size() > atlasPacker->pageCount())
+    atlasPages.resize(atlasPacker->pageCount());
+
+  image.atlasSlot = slot;
+  image.fb.release();
+  return true;
+}
+
+void CHyprView::repackAtlas() {
+  std::vector<size_t> packed;
+  for (size_t i = 0; i < images.size(); ++i) {
+    if (images[i].atlasSlot)
+      packed.push_back(i);
+  }
+
+  // Tallest first keeps shelves tight
+  std::ranges::stable_sort(packed, [this](size_t a, size_t b) {
+    return images[a].atlasSlot->height > images[b].atlasSlot->height;
+  });
+
+  atlasPacker->reset();
+  for (auto i : packed) {
+    auto &image = images[i];
+    image.atlasSlot = atlasPacker->allocate(image.atlasSlot->width,
+                                            image.atlasSlot->height);
+    // The pixels did not move along: the new slot still shows its previous
+    // occupant, the tile is neither drawn nor shared until recaptured
+    image.atlasPending = image.atlasSlot.has_value();
+    scheduleTileCapture(i, CJobScheduler::PRIORITY_VISIBLE);
+  }
+
+  atlasRepacks++;
+  Debug::log(LOG, "[hyprview] Repacked thumbnail atlas ({} tiles, {} pages)",
+             packed.size(), atlasPacker->pageCount());
+}
+
+uint32_t CHyprView::thumbnailFormat() const {
+  return thumbnailDrmFormat(config->thumbnailFormat, pMonitor.lock());
+}
+
+static size_t framebufferBytes(const CFramebuffer &fb) {
+  if (fb.m_size.x <= 0 || fb.m_size.y <= 0)
+    return 0;
+
+  const auto *FORMAT = NFormatUtils::getPixelFormatFromDRM(fb.m_drmFormat);
+  const size_t BYTESPERPIXEL = FORMAT ? FORMAT->bytesPerBlock : 4;
+  return (size_t)fb.m_size.x * (size_t)fb.m_size.y * BYTESPERPIXEL;
+}
+
+CHyprView::SVramUsage CHyprView::vramUsage() const {
+  SVramUsage usage;
+  for (const auto &image : images)
+    usage.thumbnails += framebufferBytes(image.fb);
+  for (const auto &page : atlasPages)
+    usage.atlas += framebufferBytes(*page);
+  usage.hiRes = framebufferBytes(hiResFb);
+  usage.background = framebufferBytes(bgFramebuffer);
+  return usage;
+}
+
+bool CHyprView::hasThumbnail(const SWindowImage &image) const {
+  return (image.atlasSlot && !image.atlasPending) || image.fb.m_size.x > 0;
+}
+
+void CHyprView::releaseThumbnail(SWindowImage &image) {
+  if (image.atlasSlot) {
+    atlasPacker->release(*image.atlasSlot);
+    image.atlasSlot.reset();
+  }
+  image.atlasPending = false;
+  image.fb.release();
+}
+
+std::vector<CHyprView::SEvictionCandidate>
+CHyprView::evictionCandidates() const {
+  std::vector<SEvictionCandidate> candidates;
+  for (size_t i = 0; i < images.size(); ++i) {
+    // Atlas slots share their page, giving one back frees nothing
+    const auto &image = images[i];
+    if (image.fb.m_size.x <= 0 || (int)i == visualHoveredIndex ||
+        isTileInViewport(i, false))
+      continue;
+
+    candidates.push_back({i, image.lastVisible, framebufferBytes(image.fb)});
+  }
+  return candidates;
+}
+
+void CHyprView::evictThumbnail(size_t id) {
+  if (id >= images.size() || !hasThumbnail(images[id]))
+    return;
+
+  g_pHyprRenderer->makeEGLCurrent();
+  releaseThumbnail(images[id]);
+  images[id].evicted = true;
+}
+
+bool CHyprView::scaleThumbnails(bool down) {
+  constexpr double MIN_SCALE = 0.125;
+
+  const double NEWSCALE = down ? thumbnailVramScale / 2.0
+                               : std::min(1.0, thumbnailVramScale * 2.0);
+  if (NEWSCALE < MIN_SCALE || NEWSCALE == thumbnailVramScale)
+    return false;
+
+  thumbnailVramScale = NEWSCALE;
+
+  // Shrinking only frees memory once recaptured, growing can wait for idle
+  for (size_t i = 0; i < images.size(); ++i) {
+    if (hasThumbnail(images[i]))
+      scheduleTileCapture(i, down ? CJobScheduler::PRIORITY_VISIBLE
+                                  : CJobScheduler::PRIORITY_CACHE_WARM);
+  }
+
+  Debug::log(LOG, "[hyprview] Thumbnail VRAM scale {} on {}", NEWSCALE,
+             pMonitor->m_name);
+  return true;
+}
+
+void CHyprView::captureWorkspaceImage(SWindowImage &image,
+                                      bool fullResolution) {
+  auto monitor = pMonitor.lock();
+  auto workspace = image.pWorkspace.lock();
+  auto started = startedOn.lock();
+  if (!monitor || !workspace || !started)
+    return;
+
+  // In the monitor's shape
+  const auto RENDERSIZE =
+      (monitor->m_pixelSize *
+       captureScale(image, monitor->m_pixelSize, fullResolution))
+          .floor();
+  if (RENDERSIZE.x < 1 || RENDERSIZE.y < 1)
+    return;
+
+  const auto TARGET = prepareCaptureTarget(image, RENDERSIZE, fullResolution);
+  if (!TARGET.fb)
+    return;
+
+  // Only the target rectangle, so the rest of an atlas page is kept
+  CRegion damage = TARGET.atlas ? CRegion{TARGET.box}
+                                : CRegion{0, 0, INT16_MAX, INT16_MAX};
+
+  // Kept off until after endRender, where the pass is drawn
+  std::vector<UP<CScopedNoBlur>> noBlur;
+  if (image.renderProfile != PROFILE_FULL) {
+    for (auto &window : g_pCompositor->m_windows) {
+      if (window->m_workspace == workspace)
+        noBlur.emplace_back(makeUnique<CScopedNoBlur>(window));
+    }
+  }
+
+  g_pHyprRenderer->beginRender(monitor, damage, RENDER_MODE_FULL_FAKE,
+                               nullptr, TARGET.fb);
+  g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 1.0});
+
+  // Make the workspace the visible one while it renders
+  PHLWORKSPACE openSpecial = monitor->m_activeSpecialWorkspace;
+  if (openSpecial)
+    monitor->m_activeSpecialWorkspace.reset();
+
+  started->m_visible = false;
+  monitor->m_activeWorkspace = workspace;
+  g_pDesktopAnimationManager->startAnimation(
+      workspace, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
+  workspace->m_visible = true;
+
+  g_pHyprRenderer->renderWorkspace(monitor, workspace, Time::steadyNow(),
+                                   TARGET.box);
+
+  workspace->m_visible = false;
+  g_pDesktopAnimationManager->startAnimation(
+      workspace, CDesktopAnimationManager::ANIMATION_TYPE_OUT, false, true);
+
+  g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+  g_pHyprRenderer->endRender();
+  noBlur.clear();
+  if (!TARGET.atlas)
+    updateMipmaps(*TARGET.fb, image);
+
+  monitor->m_activeSpecialWorkspace = openSpecial;
+  monitor->m_activeWorkspace = started;
+  started->m_visible = true;
+  g_pDesktopAnimationManager->startAnimation(
+      started, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
+}
+
+void CHyprView::captureWindowImage(SWindowImage &image,
+                                   bool fullResolution) {
+  if (image.pWorkspace) {
+    captureWorkspaceImage(image, fullResolution);
+    return;
+  }
+
+  auto window = image.pWindow.lock();
+  if (!window)
+    return;
+
+  const auto SOURCESIZE = window->m_realSize->value() * pMonitor->m_scale;
+  const double RESOLUTION = captureScale(image, SOURCESIZE, fullResolution);
+  const auto RENDERSIZE = (SOURCESIZE * RESOLUTION).floor();
+  if (RENDERSIZE.x < 1 || RENDERSIZE.y < 1)
+    return;
+
+  // The first capture can come from another overview showing the window,
+  // refreshes on damage render it again
+  if (!fullResolution && !hasThumbnail(image) &&
+      copySharedThumbnail(image, window, RENDERSIZE))
+    return;
+
+  const auto TARGET = prepareCaptureTarget(image, RENDERSIZE, fullResolution);
+  if (!TARGET.fb)
+    return;
+
+  // Only the target rectangle, so the rest of an atlas page is kept
+  CRegion damage = TARGET.atlas ? CRegion{TARGET.box}
+                                : CRegion{0, 0, INT16_MAX, INT16_MAX};
+
+  // Temporarily move window to monitor position for rendering
+  const auto REALPOS = window->m_realPosition->value();
+  window->m_realPosition->setValue(pMonitor->m_position);
+
+  // Kept off until after endRender, where the pass is drawn
+  std::optional<CScopedNoBlur> noBlur;
+  if (image.renderProfile != PROFILE_FULL)
+    noBlur.emplace(window);
+
+  g_pHyprRenderer->beginRender(pMonitor.lock(), damage, RENDER_MODE_FULL_FAKE,
+                               nullptr, TARGET.fb);
+
+  // Wipe what the previous occupant of the atlas slot left behind
+  if (TARGET.atlas)
+    g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 0});
+
+  if (window->m_isMapped) {
+    // Scaled down to the capture size, then moved into the atlas slot
+    SRenderModifData modif;
+    if (RESOLUTION < 1.0)
+      modif.modifs.emplace_back(SRenderModifData::RMOD_TYPE_SCALE,
+                                (float)RESOLUTION);
+    if (TARGET.atlas)
+      modif.modifs.emplace_back(SRenderModifData::RMOD_TYPE_TRANSLATE,
+                                TARGET.box.pos());
+    if (!modif.modifs.empty())
+      g_pHyprRenderer->m_renderPass.add(makeUnique<CRendererHintsPassElement>(
+          CRendererHintsPassElement::SData{modif}));
+
+    // Decorations are never drawn, popups only when the profile asks
+    g_pHyprRenderer->renderWindow(
+        window, pMonitor.lock(), Time::steadyNow(), false,
+        image.renderProfile == PROFILE_SURFACE_POPUPS ? RENDER_PASS_ALL
+                                                      : RENDER_PASS_MAIN,
+        false, false);
+
+    if (!modif.modifs.empty())
+      g_pHyprRenderer->m_renderPass.add(makeUnique<CRendererHintsPassElement>(
+          CRendererHintsPassElement::SData{SRenderModifData{}}));
+  }
+
+  g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+  g_pHyprRenderer->endRender();
+  noBlur.reset();
+  if (!TARGET.atlas)
+    updateMipmaps(*TARGET.fb, image);
+
+  // Restore original position
+  window->m_realPosition->setValue(REALPOS);
+}
+
+std::optional<CHyprView::SSharedThumbnail>
+CHyprView::sharedThumbnail(const PHLWINDOW &window) const {
+  if (closing)
+    return std::nullopt;
+
+  for (const auto &image : images) {
+    if (image.pWindow.lock() != window)
+      continue;
+    if (image.dirty || image.lowResStale || image.atlasPending)
+      return std::nullopt;
+
+    if (image.atlasSlot) {
+      const auto &SLOT = *image.atlasSlot;
+      if (SLOT.page >= atlasPages.size())
+        return std::nullopt;
+      return SSharedThumbnail{atlasPages[SLOT.page]->getTexture(),
+                              CBox{(double)SLOT.x, (double)SLOT.y,
+                                   (double)SLOT.width, (double)SLOT.height}};
+    }
+    if (image.fb.m_size.x > 0)
+      return SSharedThumbnail{image.fb.getTexture(),
+                              CBox{{0, 0}, image.fb.m_size}};
+    return std::nullopt;
+  }
+  return std::nullopt;
+}
+
+bool CHyprView::copySharedThumbnail(SWindowImage &image,
+                                    const PHLWINDOW &window,
+                                    const Vector2D &size) {
+  // Open instances only, dormant thumbnails are not kept up to date
+  std::optional<SSharedThumbnail> shared;
+  for (const auto &[monitor, instance] : g_pHyprViewInstances) {
+    if (!instance || instance.get() == this)
+      continue;
+    shared = instance->sharedThumbnail(window);
+    if (shared)
+      break;
+  }
+  if (!shared || !shared->texture || shared->texture->m_size.x <= 0 ||
+      shared->texture->m_size.y <= 0)
+    return false;
+
+  const auto TARGET = prepareCaptureTarget(image, size, false);
+  if (!TARGET.fb)
+    return false;
+
+  CRegion damage = TARGET.atlas ? CRegion{TARGET.box}
+                                : CRegion{0, 0, INT16_MAX, INT16_MAX};
+  const auto TEXSIZE = shared->texture->m_size;
+
+  g_pHyprRenderer->beginRender(pMonitor.lock(), damage, RENDER_MODE_FULL_FAKE,
+                               nullptr, TARGET.fb);
+  g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 0});
+
+  // Same UV trick as atlas tiles in fullRender()
+  g_pHyprOpenGL->m_renderData.primarySurfaceUVTopLeft =
+      shared->source.pos() / TEXSIZE;
+  g_pHyprOpenGL->m_renderData.primarySurfaceUVBottomRight =
+      (shared->source.pos() + shared->source.size()) / TEXSIZE;
+  g_pHyprOpenGL->renderTextureInternal(shared->texture, TARGET.box,
+                                       {.damage = &damage, .a = 1.f});
+  g_pHyprOpenGL->m_renderData.primarySurfaceUVTopLeft = Vector2D(-1, -1);
+  g_pHyprOpenGL->m_renderData.primarySurfaceUVBottomRight = Vector2D(-1, -1);
+
+  g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+  g_pHyprRenderer->endRender();
+  if (!TARGET.atlas)
+    updateMipmaps(*TARGET.fb, image);
+
+  sharedCaptures++;
+  return true;
+}
+
+void CHyprView::updateMipmaps(CFramebuffer &fb, const SWindowImage &image) {
+  auto tex = fb.getTexture();
+  if (!tex || image.box.width <= 0 || image.box.height <= 0)
+    return;
+
+  // How much the capture is shrunk to fit its tile in fullRender()
+  const double RATIO = std::max(fb.m_size.x / image.box.width,
+                                fb.m_size.y / image.box.height);
+  if (RATIO < MIPMAP_MIN_RATIO) {
+    tex->m_minFilter = GL_LINEAR;
+    return;
+  }
+
+  // Trilinear sampling reads a level close to the tile size instead of
+  // skipping over texels of the full capture
+  glBindTexture(GL_TEXTURE_2D, tex->m_texID);
+  glGenerateMipmap(GL_TEXTURE_2D);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  tex->m_minFilter = GL_LINEAR_MIPMAP_LINEAR;
+}
+
+void CHyprView::redrawID(int id, bool forcelowres) {
+  if (images.empty())
+    return;
+
+  if (id >= (int)images.size())
+    id = images.size() - 1;
+  if (id < 0)
+    id = 0;
+
+  blockOverviewRendering = true;
+
+  g_pHyprRenderer->makeEGLCurrent();
+
+  // The hovered tile shows its full resolution capture, only that one is
+  // kept current. The thumbnail is refreshed once hover moves on.
+  if (id == hiResIndex && hiResFb.m_size.x > 0) {
+    captureWindowImage(images[id], true);
+    images[id].lowResStale = true;
+  } else {
+    captureWindowImage(images[id]);
+  }
+
+  images[id].lastRedraw = Time::steadyNow();
+  images[id].redrawCount++;
+
+  blockOverviewRendering = false;
+}
+
+void CHyprView::redrawAll(bool forcelowres) {
+  for (size_t i = 0; i < images.size(); ++i) {
+    // Off-screen tiles of a scrolled overview have no framebuffer
+    if (hasThumbnail(images[i]))
+      redrawID(i, forcelowres);
+  }
+}
+
+bool CHyprView::isTileInViewport(size_t id, bool prefetch) const {
+  if (id >= images.size() || images[id].filteredOut)
+    return false;
+
+  static auto *const *PPREFETCH =
+      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:scroll_prefetch")
+          ->getDataStaticPtr();
+
+  const double top = scrollOffset ? scrollOffset->value() : 0.0;
+  const double viewportHeight = pMonitor->m_pixelSize.y;
+  const double margin = prefetch ? **PPREFETCH : 0.0;
+  const CBox &box = images[id].box;
+
+  return box.y + box.height >= top - margin &&
+         box.y <= top + viewportHeight + margin;
+}
+
+void CHyprView::updateVirtualizedTiles() {
+  if (canvasHeight <= pMonitor->m_pixelSize.y)
+    return;
+
+  bool madeCurrent = false;
+  for (size_t i = 0; i < images.size(); ++i) {
+    auto &image = images[i];
+    // Kept for when the filter is cleared, the VRAM budget may still take it
+    if (image.filteredOut)
+      continue;
+
+    const bool hasFramebuffer = hasThumbnail(image);
+    // Evicted tiles come back only once they are really on screen
+    const bool inViewport = isTileInViewport(i, !image.evicted);
+
+    // A slot moved by a repack holds no thumbnail yet but still its space
+    if (inViewport && !hasFramebuffer) {
+      scheduleTileCapture(i, (int)i == visualHoveredIndex
+                                 ? CJobScheduler::PRIORITY_HOVERED
+                                 : CJobScheduler::PRIORITY_VISIBLE);
+    } else if (!inViewport && (hasFramebuffer || image.atlasPending)) {
+      if (!madeCurrent) {
+        g_pHyprRenderer->makeEGLCurrent();
+        madeCurrent = true;
+      }
+      // Scrolled out of view - give the memory back
+      releaseThumbnail(image);
+    }
+  }
+}
+
+void CHyprView::scrollBy(double delta) {
+  const double maxOffset =
+      std::max(0.0, canvasHeight - pMonitor->m_pixelSize.y);
+  if (maxOffset <= 0.0)
+    return;
+
+  *scrollOffset =
+      (float)std::clamp(scrollOffset->goal() + delta, 0.0, maxOffset);
+}
+
+void CHyprView::damage() {
+  blockDamageReporting = true;
+  g_pHyprRenderer->damageMonitor(pMonitor.lock());
+  blockDamageReporting = false;
+}
+
+void CHyprView::onDamageReported(const CBox &damageBox,
+                                 const PHLWINDOW &source) {
+  if (m_collectionMode == EWindowCollectionMode::WORKSPACES) {
+    // Workspace thumbnails: only the visible workspace can produce damage
+    for (auto &image : images) {
+      if (image.pWorkspace && image.pWorkspace.lock() == pMonitor->m_activeWorkspace)
+        image.dirty = true;
+    }
+  } else if (sections.empty()) {
+    for (auto &image : images)
+      image.dirty = true;
+  } else if (source) {
+    // Grouped overview: all windows were migrated onto the active workspace
+    // and overlap there, so the box says nothing about which one changed.
+    // Only the window that committed is re-rendered, the other sections
+    // keep their tiles.
+    for (auto &image : images) {
+      if (image.pWindow.lock() == source)
+        image.dirty = true;
+    }
+  }
+
+  // Damage the entire overview area
+  damage();
+
+  // If there's a focused window, damage its tile specifically
+  if (openedID >= 0 && openedID < (int)images.size()) {
+    CBox tileBox = images[openedID].box;
+    tileBox.translate(pMonitor->m_position);
+    blockDamageReporting = true;
+    g_pHyprRenderer->damageBox(tileBox);
+    blockDamageReporting = false;
+  }
+
+  g_pCompositor->scheduleFrameForMonitor(pMonitor.lock());
+}
+
+void CHyprView::onForeignDamage(const PHLMONITOR &monitor,
+                                const CBox &damageBox,
+                                const PHLWINDOW &source) {
+  if (m_collectionMode != EWindowCollectionMode::GLOBAL || closing)
+    return;
+
+  // A commit is attributed to its window. Anything else (cursor, layers)
+  // only dirties the windows under the damage.
+  bool marked = false;
+  for (auto &image : images) {
+    auto window = image.pWindow.lock();
+    if (!window)
+      continue;
+
+    const bool HIT =
+        source ? window == source
+               : CBox{window->m_realPosition->value() - monitor->m_position,
+                      window->m_realSize->value()}
+                     .scale(monitor->m_scale)
+                     .overlaps(damageBox);
+    if (HIT) {
+      image.dirty = true;
+      marked = true;
+    }
+  }
+
+  if (marked)
+    g_pCompositor->scheduleFrameForMonitor(pMonitor.lock());
+}
+
+void CHyprView::close() {
+
+  if (closing) {
+    Debug::log(LOG, "[hyprview] close(): already closing, returning");
+    return;
+  }
+
+  closing = true;
+
+  // Save the selected window before cleanup
+  PHLWINDOW selectedWindow = nullptr;
+  if (userExplicitlySelected && closeOnID >= 0 &&
+      closeOnID < (int)images.size()) {
+    selectedWindow = images[closeOnID].pWindow.lock();
+  }
+
+  // STEP 1: Restore ALL windows to their original workspaces
+  // The overview layer continues rendering during this process to hide the movement
+  Debug::log(
+      LOG, "[hyprview] close(): Restoring all windows to original workspaces");
+  for (const auto &image : images) {
+    auto window = image.pWindow.lock();
+    auto original = image.originalWorkspace.lock();
+    if (window && original && window->m_workspace != original) {
+      Debug::log(
+          LOG,
+          "[hyprview] close(): Restoring window '{}' from workspace {} to {}",
+          window->m_title, window->m_workspace->m_id, original->m_id);
+      window->moveToWorkspace(original);
+    }
+  }
+
+  // Pending captures would only slow down the closing animation
+  jobs.clear();
+
+  // STEP 2: Start closing animationi - animate scale back to 0
+  Debug::log(LOG, "[hyprview] close(): Start closing animation");
+  *scale = 0.0f;
+
+  // Workspace tile selected: switch to that workspace
+  if (userExplicitlySelected && closeOnID >= 0 &&
+      closeOnID < (int)images.size()) {
+    auto selected = images[closeOnID].pWorkspace.lock();
+    if (selected && selected != pMonitor->m_activeWorkspace) {
+      Debug::log(LOG, "[hyprview] close(): Switching to workspace {}",
+                 selected->m_id);
+      pMonitor->changeWorkspace(selected);
+    }
+  }
+
+  // STEP 3: Focus the selected window to trigger all lifecycle events
+  if (userExplicitlySelected && selectedWindow) {
+    g_pCompositor->focusWindow(selectedWindow);
+    g_pKeybindManager->alterZOrder("top");
+  }
+}
+
+void CHyprView::onPreRender() {
+  if (!closing)
+    flushPointerMotion();
+
+  if (!closing)
+    updateVirtualizedTiles();
+
+  if (!closing)
+    refreshDirtyTiles();
+
+  if (!closing)
+    runJobs();
+
+  // If we're closing and animation has finished, do cleanup
+  if (closing && scale->value() <= 0.01f && !readyForCleanup) {
+    Debug::log(LOG, "[hyprview] onPreRender(): Closing animation complete, cleaning up");
+    finishClose();
+  }
+}
+
+void CHyprView::finishClose() {
+  static auto *const *PRESIDENT =
+      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:resident")
+          ->getDataStaticPtr();
+
+  if (readyForCleanup)
+    return;
+
+  readyForCleanup = true;
+  resident = **PRESIDENT != 0;
+
+  jobs.clear();
+  if (refreshTimer) {
+    wl_event_source_remove(refreshTimer);
+    refreshTimer = nullptr;
+  }
+  if (idleSource) {
+    wl_event_source_remove(idleSource);
+    idleSource = nullptr;
+  }
+
+  g_pHyprRenderer->makeEGLCurrent();
+  hiResFb.release();
+  hiResIndex = -1;
+  filterTexture.reset();
+  filterTextureKey.clear();
+  filterQuery.clear();
+  restoreUnfilteredLayout();
+
+  // A resident instance keeps its thumbnails for the next open
+  if (!resident) {
+    images.clear();
+    searchIndex.clear();
+    atlasPages.clear();
+    atlasPacker.reset();
+    bgFramebuffer.release();
+  }
+
+  g_pInputManager->unsetCursorImage();
+  g_pHyprOpenGL->markBlurDirtyForMonitor(pMonitor.lock());
+}
+
+bool CHyprView::reopen(PHLWORKSPACE startedOn_, bool swipe_,
+                       EWindowCollectionMode mode,
+                       const std::string &placement, bool explicitOn,
+                       bool deferBackground) {
+  auto monitor = pMonitor.lock();
+  if (!monitor || !monitor->m_enabled || !closing ||
+      mode != m_collectionMode || placement != m_placement ||
+      !startedOn_ || startedOn_ != startedOn.lock() ||
+      monitor->m_activeWorkspace != startedOn_ ||
+      bgFramebuffer.m_size != monitor->m_pixelSize)
+    return false;
+
+  // Same tiles in the same order, otherwise the layout would differ
+  if (m_collectionMode == EWindowCollectionMode::WORKSPACES) {
+    const auto WORKSPACES = collectWorkspaces();
+    if (WORKSPACES.size() != images.size())
+      return false;
+    for (size_t i = 0; i < images.size(); ++i) {
+      if (images[i].pWorkspace.lock() != WORKSPACES[i])
+        return false;
+    }
+  } else {
+    const auto WINDOWS = collectWindows(startedOn_);
+    if (WINDOWS.size() != images.size())
+      return false;
+    for (size_t i = 0; i < images.size(); ++i) {
+      const auto &image = images[i];
+      if (image.pWindow.lock() != WINDOWS[i] ||
+          WINDOWS[i]->m_workspace != image.originalWorkspace.lock() ||
+          WINDOWS[i]->m_realSize->value() != image.originalSize)
+        return false;
+    }
+  }
+
+  // Dormant, or still animating its close
+  const bool DORMANT = readyForCleanup;
+  Debug::log(LOG, "[hyprview] reopen(): Reusing {} overview on {}",
+             DORMANT ? "resident" : "closing", monitor->m_name);
+
+  // Same order as the constructor: background first, then migrate windows.
+  // A closing instance still has its background from the open.
+  if (DORMANT && deferBackground)
+    bgCaptured = false;
+  else if (DORMANT)
+    captureBackground();
+  blockOverviewRendering = true;
+
+  g_pHyprRenderer->makeEGLCurrent();
+  g_pHyprRenderer->m_bBlockSurfaceFeedback = true;
+  for (auto &image : images) {
+    auto window = image.pWindow.lock();
+    if (!window)
+      continue;
+
+    image.originalPos = window->m_realPosition->value();
+    if (window->m_workspace != monitor->m_activeWorkspace)
+      window->moveToWorkspace(monitor->m_activeWorkspace);
+  }
+  g_pHyprRenderer->m_bBlockSurfaceFeedback = false;
+
+  closing = false;
+  readyForCleanup = false;
+  resident = false;
+  swipe = swipe_;
+  m_isSwiping = false;
+  swipeWasCommenced = false;
+  stickyOn = explicitOn;
+
+  originalFocusedWindow = g_pCompositor->m_lastWindow;
+  userExplicitlySelected = false;
+  lastHoveredWindow.reset();
+  closeOnID = -1;
+  currentHoveredIndex = -1;
+  visualHoveredIndex = -1;
+  openedID = images.empty() ? -1 : 0;
+
+  setHiResTile(-1);
+
+  // Window rules may have matched differently since
+  resolveTileRules();
+
+  // Every open starts unfiltered, titles may have changed while closed
+  filterQuery.clear();
+  restoreUnfilteredLayout();
+  buildSearchIndex();
+
+  if (!refreshTimer)
+    createRefreshTimer();
+  openedAt = Time::steadyNow();
+  pointerMotionPending = false;
+  pointerEvents = 0;
+  pointerHitTests = 0;
+  if (DORMANT)
+    scrollOffset->setValueAndWarp(0.0f);
+
+  // Kept thumbnails are shown right away and refreshed by their policy,
+  // tiles that had none are captured as on a fresh open
+  for (size_t i = 0; i < images.size(); ++i) {
+    if (hasThumbnail(images[i]))
+      images[i].dirty = true;
+    else if (isTileInViewport(i))
+      scheduleTileCapture(i, CJobScheduler::PRIORITY_VISIBLE);
+  }
+
+  // A closing instance turns around from wherever its animation is
+  if (DORMANT)
+    scale->setValueAndWarp(0.0f);
+  if (!swipe)
+    *scale = 1.0f;
 
-  // Safety validation - ensure we have a valid window to select
-  if (closeOnID < 0 || closeOnID >= (int)images.size()) {
-    Debug::log(WARN,
-               "[hyprview] selectHoveredWindow(): Invalid currentHoveredIndex "
-               "{}, recalculating from mouse position",
-               closeOnID);
+  g_pInputManager->setCursorImageUntilUnset("left_ptr");
+  lastMousePosLocal =
+      g_pInputManager->getMouseCoordsInternal() - monitor->m_position;
 
-    // Fallback: recalculate from current mouse position
-    closeOnID = getWindowIndexFromMousePos(lastMousePosLocal);
+  blockOverviewRendering = false;
+  return true;
+}
 
-    // Final fallback: use bounds-clamped value
-    if (closeOnID < 0 || closeOnID >= (int)images.size()) {
-      closeOnID = std::max(0, std::min((int)images.size() - 1, 0));
-    }
+std::unique_ptr<CHyprView> openHyprView(PHLMONITOR monitor,
+                                        PHLWORKSPACE startedOn, bool swipe,
+                                        EWindowCollectionMode mode,
+                                        const std::string &placement,
+                                        bool explicitOn,
+                                        bool deferBackground) {
+  // Opened again during its close animation: turn that one around
+  auto active = g_pHyprViewInstances.find(monitor);
+  if (active != g_pHyprViewInstances.end() && active->second &&
+      active->second->closing) {
+    auto instance = std::move(active->second);
+    g_pHyprViewInstances.erase(active);
+
+    if (!instance->readyForCleanup &&
+        instance->reopen(startedOn, swipe, mode, placement, explicitOn,
+                         deferBackground))
+      return instance;
+
+    retireHyprView(monitor, std::move(instance));
   }
 
-  // Verify the selected window is valid
-  if (closeOnID >= 0 && closeOnID < (int)images.size()) {
-    auto selectedWindow = images[closeOnID].pWindow.lock();
-    if (!selectedWindow || !selectedWindow->m_isMapped) {
-      Debug::log(WARN,
-                 "[hyprview] selectHoveredWindow(): Selected window at index "
-                 "{} is invalid",
-                 closeOnID);
-    }
-  }
+  auto it = g_pHyprViewDormant.find(monitor);
+  if (it != g_pHyprViewDormant.end()) {
+    auto instance = std::move(it->second);
+    g_pHyprViewDormant.erase(it);
 
-  userExplicitlySelected = true;
+    if (instance &&
+        instance->reopen(startedOn, swipe, mode, placement, explicitOn,
+                         deferBackground))
+      return instance;
 
-  Debug::log(LOG,
-             "[hyprview] selectHoveredWindow(): User explicitly selected "
-             "window at index {} (from currentHoveredIndex {})",
-             closeOnID, currentHoveredIndex);
+    Debug::log(LOG, "[hyprview] Resident overview on {} is stale, rebuilding",
+               monitor->m_name);
+  }
+
+  return std::make_unique<CHyprView>(monitor, startedOn, swipe, mode,
+                                     placement, explicitOn, deferBackground);
 }
 
-void CHyprView::redrawID(int id, bool forcelowres) {
-  blockOverviewRendering = true;
+void openHyprViews(const std::vector<PHLMONITOR> &monitors,
+                   EWindowCollectionMode mode, const std::string &placement,
+                   bool explicitOn) {
+  static auto *const *PBUDGET =
+      (Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:frame_budget_ms")
+          ->getDataStaticPtr();
 
-  g_pHyprRenderer->makeEGLCurrent();
+  // Built as if swiped in, so none starts animating before the last one is
+  // ready
+  std::vector<CHyprView *> opened;
+  for (const auto &monitor : monitors) {
+    if (!monitor->m_enabled || !monitor->m_activeWorkspace)
+      continue;
 
-  if (id >= (int)images.size())
-    id = images.size() - 1;
-  if (id < 0)
-    id = 0;
+    auto instance = openHyprView(monitor, monitor->m_activeWorkspace, true,
+                                 mode, placement, explicitOn, true);
+    opened.push_back(instance.get());
+    g_pHyprViewInstances[monitor] = std::move(instance);
+  }
 
-  auto &image = images[id];
-  auto window = image.pWindow.lock();
-  if (!window) {
-    blockOverviewRendering = false;
+  if (opened.empty())
     return;
-  }
 
-  const auto RENDERSIZE =
-      (window->m_realSize->value() * pMonitor->m_scale).floor();
-  if (RENDERSIZE.x < 1 || RENDERSIZE.y < 1) {
+  // Backgrounds and focused tiles of every monitor under one context,
+  // whatever does not fit the shared budget continues from preRender
+  g_pHyprRenderer->makeEGLCurrent();
+  const double BUDGET = **PBUDGET / opened.size();
+  for (auto *instance : opened)
+    instance->startOpen(BUDGET);
+
+  Debug::log(LOG, "[hyprview] Opened {} overviews as one batch",
+             opened.size());
+}
+
+void CHyprView::startOpen(double captureBudgetMs) {
+  // Deferred by openHyprViews(), rendered normally by the workspace hook
+  if (!bgCaptured) {
+    blockOverviewRendering = true;
+    captureBackground();
     blockOverviewRendering = false;
-    return;
   }
 
-  if (image.fb.m_size.x != RENDERSIZE.x || image.fb.m_size.y != RENDERSIZE.y) {
-    image.fb.release();
-    image.fb.alloc(RENDERSIZE.x, RENDERSIZE.y,
-                   pMonitor->m_output->state->state().drmFormat);
+  if (!jobs.empty()) {
+    gpuTimer.begin(CGpuTimer::PASS_REDRAW);
+    const size_t RAN = jobs.drain(captureBudgetMs);
+    gpuTimer.end();
+    if (RAN > 0)
+      damage();
   }
 
-  CRegion fakeDamage{0, 0, INT16_MAX, INT16_MAX};
+  swipe = false;
+  *scale = 1.0f;
+}
 
-  const auto REALPOS = window->m_realPosition->value();
-  window->m_realPosition->setValue(pMonitor->m_position);
+void retireHyprView(PHLMONITOR monitor, std::unique_ptr<CHyprView> instance) {
+  if (!instance)
+    return;
 
-  g_pHyprRenderer->beginRender(pMonitor.lock(), fakeDamage,
-                               RENDER_MODE_FULL_FAKE, nullptr, &image.fb);
+  instance->finishClose();
+  if (instance->resident)
+    g_pHyprViewDormant[monitor] = std::move(instance);
+}
 
-  if (window->m_isMapped) {
-    g_pHyprRenderer->renderWindow(window, pMonitor.lock(), Time::steadyNow(),
-                                  false, RENDER_PASS_MAIN, false, false);
-  }
+void CHyprView::renderSectionHeaders(float alpha) {
+  CRegion damage{0, 0, INT16_MAX, INT16_MAX};
+
+  for (size_t s = 0; s < sections.size(); ++s) {
+    auto &section = sections[s];
+
+    // Rasterized once per overview, not per frame
+    if (!section.headerTexture && section.workspace) {
+      jobs.schedule(CJobScheduler::JOB_SECTION_HEADER, s,
+                    CJobScheduler::PRIORITY_LABEL, [this, s] {
+                      auto &section = sections[s];
+                      auto monitor = section.monitor.lock();
+                      auto workspace = section.workspace.lock();
+                      if (!monitor && !workspace)
+                        return;
+                      const std::string HEADERTEXT =
+                          monitor ? monitor->m_name
+                          : workspace->m_isSpecialWorkspace
+                              ? workspace->m_name
+                              : "Workspace " + workspace->m_name;
+                      section.headerTexture = g_pHyprOpenGL->renderText(
+                          HEADERTEXT, config->windowTextColor, config->windowNameFontSize,
+                          false, "sans-serif");
+                    });
+    }
 
-  g_pHyprOpenGL->m_renderData.blockScreenShader = true;
-  g_pHyprRenderer->endRender();
+    CBox headerBox = section.header;
+    headerBox.y -= scrollOffset->value();
+    headerBox.translate(pos->value());
 
-  window->m_realPosition->setValue(REALPOS);
+    CHyprOpenGLImpl::SRectRenderData bgData;
+    bgData.round = 4;
+    g_pHyprOpenGL->renderRect(
+        headerBox, CHyprColor(0.0, 0.0, 0.0, config->windowNameBgOpacity * alpha),
+        bgData);
 
-  blockOverviewRendering = false;
-}
+    if (!section.headerTexture)
+      continue;
 
-void CHyprView::redrawAll(bool forcelowres) {
-  for (size_t i = 0; i < images.size(); ++i) {
-    redrawID(i, forcelowres);
+    const double TEXTWIDTH =
+        std::min(section.headerTexture->m_size.x * 0.8, headerBox.width);
+    const double TEXTHEIGHT = section.headerTexture->m_size.y * 0.8;
+    CBox textBox = {headerBox.x + (headerBox.width - TEXTWIDTH) / 2.0,
+                    headerBox.y + (headerBox.height - TEXTHEIGHT) / 2.0,
+                    TEXTWIDTH, TEXTHEIGHT};
+    textBox.round();
+    g_pHyprOpenGL->renderTextureInternal(
+        section.headerTexture, textBox,
+        {.damage = &damage, .a = alpha, .round = 0});
   }
 }
 
-void CHyprView::damage() {
-  blockDamageReporting = true;
-  g_pHyprRenderer->damageMonitor(pMonitor.lock());
-  blockDamageReporting = false;
+void CHyprView::renderFilterLabel() {
+  if (!filterTexture)
+    return;
+
+  // Centered at the top of the monitor, above the tiles
+  const double PADDING = 8.0;
+  const double TEXTWIDTH = std::min(filterTexture->m_size.x * 0.8,
+                                    pMonitor->m_pixelSize.x - 4 * PADDING);
+  const double TEXTHEIGHT = filterTexture->m_size.y * 0.8;
+  CBox bgBox = {(pMonitor->m_pixelSize.x - TEXTWIDTH) / 2.0 - 2 * PADDING,
+                pMonitor->m_reservedTopLeft.y + PADDING,
+                TEXTWIDTH + 4 * PADDING, TEXTHEIGHT + 2 * PADDING};
+  CBox textBox = {bgBox.x + 2 * PADDING, bgBox.y + PADDING, TEXTWIDTH,
+                  TEXTHEIGHT};
+  bgBox.round();
+  textBox.round();
+
+  CHyprOpenGLImpl::SRectRenderData bgData;
+  bgData.round = 8;
+  g_pHyprOpenGL->renderRect(
+      bgBox, CHyprColor(0.0, 0.0, 0.0, config->windowNameBgOpacity), bgData);
+
+  CRegion damage{0, 0, INT16_MAX, INT16_MAX};
+  g_pHyprOpenGL->renderTextureInternal(filterTexture, textBox,
+                                       {.damage = &damage, .a = 1.0, .round = 0});
 }
 
-void CHyprView::onDamageReported() {
-  damageDirty = true;
+void CHyprView::refreshDirtyTiles() {
+  const auto NOW = Time::steadyNow();
+  std::optional<Time::steady_tp> nextDue;
 
-  // Damage the entire overview area
-  damage();
+  for (size_t i = 0; i < images.size(); ++i) {
+    auto &image = images[i];
+    if (!image.dirty)
+      continue;
 
-  // If there's a focused window, damage its tile specifically
-  if (openedID >= 0 && openedID < (int)images.size()) {
-    CBox tileBox = images[openedID].box;
-    tileBox.translate(pMonitor->m_position);
-    blockDamageReporting = true;
-    g_pHyprRenderer->damageBox(tileBox);
-    blockDamageReporting = false;
+    // Off-screen tiles of a scrolled overview have no framebuffer, they are
+    // captured fresh when they come back into view
+    if (!hasThumbnail(image)) {
+      image.dirty = false;
+      continue;
+    }
+
+    // Under load the quality controller caps refreshes below the tile's own
+    // policy
+    SRefreshPolicy policy = image.refreshPolicy;
+    const double CAP = quality.settings().maxRefreshFps;
+    if (CAP > 0.0 && (policy.mode == SRefreshPolicy::LIVE ||
+                      (policy.mode == SRefreshPolicy::FPS && policy.fps > CAP)))
+      policy = {SRefreshPolicy::FPS, CAP};
+
+    switch (policy.mode) {
+    case SRefreshPolicy::STATIC:
+      image.dirty = false;
+      continue;
+
+    case SRefreshPolicy::FPS: {
+      const auto DUE =
+          image.lastRedraw +
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(1.0 / policy.fps));
+      if (NOW < DUE) {
+        // Keep it dirty, the timer brings us back when it is due
+        if (!nextDue || DUE < *nextDue)
+          nextDue = DUE;
+        continue;
+      }
+      break;
+    }
+
+    case SRefreshPolicy::LIVE:
+      break;
+    }
+
+    image.dirty = false;
+    scheduleTileCapture(i, (int)i == visualHoveredIndex
+                               ? CJobScheduler::PRIORITY_HOVERED
+                               : CJobScheduler::PRIORITY_VISIBLE);
   }
 
-  g_pCompositor->scheduleFrameForMonitor(pMonitor.lock());
+  if (nextDue && refreshTimer) {
+    const auto DELAY = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           *nextDue - NOW)
+                           .count();
+    wl_event_source_timer_update(refreshTimer, std::max<int>(1, (int)DELAY));
+  }
 }
 
-void CHyprView::close() {
+void CHyprView::setHiResTile(int index) {
+  static auto *const *PLOD =
+      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:thumbnail_lod")
+          ->getDataStaticPtr();
 
-  if (closing) {
-    Debug::log(LOG, "[hyprview] close(): already closing, returning");
+  // Without LOD every tile already is at full resolution
+  if (!**PLOD || index >= (int)images.size())
+    index = -1;
+
+  if (index == hiResIndex)
     return;
-  }
 
-  closing = true;
+  // The thumbnail missed refreshes while the full resolution one was shown
+  if (hiResIndex >= 0 && hiResIndex < (int)images.size() &&
+      images[hiResIndex].lowResStale) {
+    images[hiResIndex].lowResStale = false;
+    images[hiResIndex].dirty = true;
+  }
 
-  // Save the selected window before cleanup
-  PHLWINDOW selectedWindow = nullptr;
-  if (userExplicitlySelected && closeOnID >= 0 &&
-      closeOnID < (int)images.size()) {
-    selectedWindow = images[closeOnID].pWindow.lock();
+  if (hiResFb.m_size.x > 0) {
+    g_pHyprRenderer->makeEGLCurrent();
+    hiResFb.release();
   }
 
-  // STEP 1: Restore ALL windows to their original workspaces
-  // The overview layer continues rendering during this process to hide the movement
-  Debug::log(
-      LOG, "[hyprview] close(): Restoring all windows to original workspaces");
-  for (const auto &image : images) {
-    auto window = image.pWindow.lock();
-    if (window && image.originalWorkspace &&
-        window->m_workspace != image.originalWorkspace) {
-      Debug::log(
-          LOG,
-          "[hyprview] close(): Restoring window '{}' from workspace {} to {}",
-          window->m_title, window->m_workspace->m_id,
-          image.originalWorkspace->m_id);
-      window->moveToWorkspace(image.originalWorkspace);
+  hiResIndex = index;
+  if (index < 0)
+    return;
+
+  jobs.schedule(CJobScheduler::JOB_HIRES_CAPTURE, index,
+                CJobScheduler::PRIORITY_HOVERED, [this, index] {
+                  // Hover moved on while waiting
+                  if (index != hiResIndex)
+                    return;
+
+                  blockOverviewRendering = true;
+                  captureWindowImage(images[index], true);
+                  blockOverviewRendering = false;
+                });
+}
+
+void CHyprView::scheduleTileCapture(size_t id,
+                                    CJobScheduler::ePriority priority) {
+  jobs.schedule(CJobScheduler::JOB_TILE_CAPTURE, id, priority, [this, id] {
+    if (id >= images.size())
+      return;
+
+    // Refresh of a captured tile
+    if (hasThumbnail(images[id])) {
+      redrawID(id);
+      return;
     }
-  }
 
-  // STEP 2: Start closing animationi - animate scale back to 0
-  Debug::log(LOG, "[hyprview] close(): Start closing animation");
-  *scale = 0.0f;
+    // First capture, unless it was scrolled away while waiting. A slot
+    // moved by a repack is given back then, nothing else would.
+    if (!isTileInViewport(id, !images[id].evicted)) {
+      if (images[id].atlasPending)
+        releaseThumbnail(images[id]);
+      return;
+    }
 
-  // STEP 3: Focus the selected window to trigger all lifecycle events
-  if (userExplicitlySelected && selectedWindow) {
-    g_pCompositor->focusWindow(selectedWindow);
-    g_pKeybindManager->alterZOrder("top");
-  }
+    blockOverviewRendering = true;
+    captureWindowImage(images[id]);
+    images[id].lastRedraw = Time::steadyNow();
+    images[id].evicted = false;
+    blockOverviewRendering = false;
+  });
 }
 
-void CHyprView::onPreRender() {
-  if (damageDirty && !closing) {
-    damageDirty = false;
-    redrawAll(false);
-  }
+void CHyprView::runJobs() {
+  static auto *const *PBUDGET =
+      (Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:frame_budget_ms")
+          ->getDataStaticPtr();
 
-  // If we're closing and animation has finished, do cleanup
-  if (closing && scale->value() <= 0.01f && !readyForCleanup) {
-    Debug::log(LOG, "[hyprview] onPreRender(): Closing animation complete, cleaning up");
-    readyForCleanup = true;
-    images.clear();
-    bgFramebuffer.release();
-    g_pInputManager->unsetCursorImage();
-    g_pHyprOpenGL->markBlurDirtyForMonitor(pMonitor.lock());
+  if (jobs.empty())
+    return;
+
+  g_pHyprRenderer->makeEGLCurrent();
+  gpuTimer.begin(CGpuTimer::PASS_REDRAW);
+  const size_t RAN = jobs.drain(**PBUDGET);
+  gpuTimer.end();
+  if (RAN > 0)
+    damage();
+
+  if (jobs.empty())
+    return;
+
+  // Tiles on screen continue next frame, labels and warm-up whenever the
+  // event loop has nothing else to do
+  if (jobs.hasPending(CJobScheduler::PRIORITY_VISIBLE)) {
+    g_pCompositor->scheduleFrameForMonitor(pMonitor.lock());
+  } else if (!idleSource) {
+    idleSource = wl_event_loop_add_idle(
+        g_pCompositor->m_wlEventLoop,
+        [](void *data) {
+          auto *self = (CHyprView *)data;
+          // Idle sources are one-shot, the event loop frees it
+          self->idleSource = nullptr;
+          if (!self->closing)
+            self->runJobs();
+        },
+        this);
   }
 }
 
 void CHyprView::onWorkspaceChange() {}
 
 void CHyprView::render() {
-  g_pHyprRenderer->m_renderPass.add(makeUnique<CHyprViewPassElement>(this));
+  g_pHyprRenderer->m_renderPass.add(
+      makeUnique<CHyprViewPassElement>(selfHandle));
 }
 
 void CHyprView::fullRender() {
+  const auto RENDERSTART = Time::steadyNow();
+  gpuTimer.begin(CGpuTimer::PASS_RENDER);
+
   // Get the current scale value for smooth scale animation
   const float currentScale = scale->value();
   const float currentAlpha = 1.0f; // Keep alpha fixed, removing all fade animations
@@ -859,7 +2266,7 @@ void CHyprView::fullRender() {
 
     // Add a dim overlay that fades in with the overview
     g_pHyprOpenGL->renderRect(
-        monitorBox, CHyprColor(0.0, 0.0, 0.0, BG_DIM * currentAlpha), {});
+        monitorBox, CHyprColor(0.0, 0.0, 0.0, config->bgDim * currentAlpha), {});
   }
 
   // If no windows, show centered message
@@ -899,6 +2306,11 @@ void CHyprView::fullRender() {
     return;
   }
 
+  // Section headers fade in with the tiles. A filtered overview is one
+  // layout without sections.
+  if (!sections.empty() && filterQuery.empty())
+    renderSectionHeaders(currentScale);
+
   const auto PLASTWINDOW = g_pCompositor->m_lastWindow.lock();
   const auto PLASTWORKSPACE = g_pCompositor->m_lastWindow.lock();
 
@@ -933,15 +2345,49 @@ void CHyprView::fullRender() {
     return itA->second < itB->second;
   });
 
+  static auto *const *PHOVERZOOM =
+      (Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:hover_zoom")
+          ->getDataStaticPtr();
+  const double HOVERZOOM = std::max(1.0, (double)**PHOVERZOOM);
+
+  // A zoomed tile grows over its neighbours, draw it last
+  if (HOVERZOOM > 1.0 && visualHoveredIndex >= 0) {
+    auto it = std::ranges::find(renderOrder, (size_t)visualHoveredIndex);
+    if (it != renderOrder.end())
+      std::rotate(it, it + 1, renderOrder.end());
+  }
+
   for (auto i : renderOrder) {
-    const Vector2D &textureSize = images[i].fb.m_size;
+    if (images[i].filteredOut)
+      continue;
+
+    // The hovered tile is drawn from its full resolution capture once ready
+    const bool HIRES = (int)i == hiResIndex && hiResFb.m_size.x > 0;
+    const auto &ATLASSLOT = images[i].atlasSlot;
+    const bool ATLASED = !HIRES && ATLASSLOT;
+    // Moved by a repack: border and label stay, the slot's pixels don't
+    const bool PENDING = ATLASED && images[i].atlasPending;
+
+    const CFramebuffer &tileFb =
+        HIRES ? hiResFb
+              : (ATLASED ? *atlasPages[ATLASSLOT->page] : images[i].fb);
+    const Vector2D textureSize =
+        ATLASED ? Vector2D{(double)ATLASSLOT->width, (double)ATLASSLOT->height}
+                : tileFb.m_size;
 
     if (textureSize.x < 1 || textureSize.y < 1)
       continue;
 
     // Use the EXACT box position calculated by the placement algorithm
     // No modifications, no centering - the placement algorithm is authoritative
+    // (only shifted by the scroll position of the virtual canvas)
     CBox tileBox = images[i].box;
+    tileBox.y -= scrollOffset->value();
+
+    // Recency for the VRAM budget's eviction order
+    if (tileBox.y + tileBox.height > 0 && tileBox.y < pMonitor->m_pixelSize.y)
+      images[i].lastVisible = RENDERSTART;
 
     // Calculate aspect-ratio-preserving size within the tile
     const double textureAspect = textureSize.x / textureSize.y;
@@ -961,6 +2407,12 @@ void CHyprView::fullRender() {
     const double offsetY = (tileBox.height - newSize.y) / 2.0;
     Vector2D newPos = {tileBox.x + offsetX, tileBox.y + offsetY};
 
+    // Zoom on hover, around the tile center
+    if ((int)i == visualHoveredIndex && HOVERZOOM > 1.0) {
+      newPos = newPos - newSize * (HOVERZOOM - 1.0) / 2.0;
+      newSize = newSize * HOVERZOOM;
+    }
+
     // Interpolate position and size for move animation
     Vector2D originalPosLocal = images[i].originalPos - pMonitor->m_position;
     Vector2D animPos = lerp(originalPosLocal, newPos, currentScale);
@@ -968,14 +2420,17 @@ void CHyprView::fullRender() {
 
     CBox windowBox = {animPos.x, animPos.y, animSize.x, animSize.y};
     CBox borderBox = {
-        windowBox.x - BORDER_WIDTH,
-        windowBox.y - BORDER_WIDTH,
-        windowBox.width + 2 * BORDER_WIDTH,
-        windowBox.height + 2 * BORDER_WIDTH};
-
-    const bool ISACTIVE = images[i].pWindow.lock() == PLASTWINDOW;
+        windowBox.x - config->borderWidth,
+        windowBox.y - config->borderWidth,
+        windowBox.width + 2 * config->borderWidth,
+        windowBox.height + 2 * config->borderWidth};
+
+    const bool ISACTIVE =
+        images[i].pWorkspace
+            ? images[i].pWorkspace.lock() == pMonitor->m_activeWorkspace
+            : images[i].pWindow.lock() == PLASTWINDOW;
     const auto &BORDERCOLOR =
-        ISACTIVE ? ACTIVE_BORDER_COLOR : INACTIVE_BORDER_COLOR;
+        ISACTIVE ? config->activeBorderColor : config->inactiveBorderColor;
 
     // Translate both boxes for the overview animation
     borderBox.translate(pos->value());
@@ -988,17 +2443,37 @@ void CHyprView::fullRender() {
     fadedBorderColor.a *= currentAlpha;
 
     CHyprOpenGLImpl::SRectRenderData data;
-    data.round = BORDER_RADIUS;
+    data.round = config->borderRadius;
     g_pHyprOpenGL->renderRect(borderBox, fadedBorderColor, data);
 
+    // Atlas tiles sample only their slot of the page
+    if (ATLASED) {
+      g_pHyprOpenGL->m_renderData.primarySurfaceUVTopLeft =
+          Vector2D{ATLASSLOT->x / tileFb.m_size.x,
+                   ATLASSLOT->y / tileFb.m_size.y};
+      g_pHyprOpenGL->m_renderData.primarySurfaceUVBottomRight =
+          Vector2D{(ATLASSLOT->x + ATLASSLOT->width) / tileFb.m_size.x,
+                   (ATLASSLOT->y + ATLASSLOT->height) / tileFb.m_size.y};
+    }
+
     CRegion damage{0, 0, INT16_MAX, INT16_MAX};
-    g_pHyprOpenGL->renderTextureInternal(
-        images[i].fb.getTexture(), windowBox,
-        {.damage = &damage, .a = currentAlpha, .round = BORDER_RADIUS});
+    if (PENDING)
+      g_pHyprOpenGL->renderRect(
+          windowBox, CHyprColor(1.0, 1.0, 1.0, 0.08 * currentAlpha), data);
+    else
+      g_pHyprOpenGL->renderTextureInternal(
+          tileFb.getTexture(), windowBox,
+          {.damage = &damage, .a = currentAlpha, .round = config->borderRadius});
+
+    if (ATLASED) {
+      g_pHyprOpenGL->m_renderData.primarySurfaceUVTopLeft = Vector2D(-1, -1);
+      g_pHyprOpenGL->m_renderData.primarySurfaceUVBottomRight =
+          Vector2D(-1, -1);
+    }
 
     // Render workspace number indicator (if enabled and window names are disabled)
     // When window names are enabled, the workspace ID is integrated into the window name
-    if (WORKSPACE_INDICATOR_ENABLED && !WINDOW_NAME_ENABLED) {
+    if (config->workspaceIndicatorEnabled && !config->windowNameEnabled) {
       auto window = images[i].pWindow.lock();
       if (window && images[i].originalWorkspace) {
         renderWorkspaceIndicator(i, borderBox, damage, ISACTIVE);
@@ -1006,22 +2481,70 @@ void CHyprView::fullRender() {
     }
 
     // Render window name (if enabled)
-    if (WINDOW_NAME_ENABLED) {
-      renderWindowName(images[i], borderBox);
+    if (config->windowNameEnabled) {
+      renderWindowName(i, borderBox);
+    }
+  }
+
+  if (!filterQuery.empty() && !closing)
+    renderFilterLabel();
+
+  // Results of earlier frames, the GPU is still working on this one
+  gpuTimer.endFrame();
+  for (const auto &times : gpuTimer.collect()) {
+    if (!closing)
+      recordFrameCost(times);
+  }
+}
+
+void CHyprView::recordFrameCost(const CGpuTimer::SFrameTimes &times) {
+  static auto *const *PBUDGET =
+      (Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:frame_budget_ms")
+          ->getDataStaticPtr();
+  static auto *const *PADAPTIVE =
+      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+          PHANDLE, "plugin:hyprview:adaptive_quality")
+          ->getDataStaticPtr();
+
+  const double INTERVAL =
+      pMonitor->m_refreshRate > 0 ? 1000.0 / pMonitor->m_refreshRate : 0.0;
+  const int OLDLEVEL = quality.level();
+  const double REDRAWMS = times[CGpuTimer::PASS_REDRAW];
+  const double FRAMEMS = times[CGpuTimer::PASS_RENDER] + REDRAWMS;
+  if (!quality.addSample(FRAMEMS, REDRAWMS, INTERVAL, **PBUDGET,
+                         **PADAPTIVE != 0))
+    return;
+
+  Debug::log(LOG, "[hyprview] Quality level {} -> {} (frame interval {}ms)",
+             OLDLEVEL, quality.level(), INTERVAL);
+
+  // Lower quality applies with the next refresh of each tile. Going back up,
+  // tiles are recaptured at full resolution when the compositor is idle.
+  if (quality.level() < OLDLEVEL) {
+    for (size_t i = 0; i < images.size(); ++i) {
+      if (hasThumbnail(images[i]))
+        scheduleTileCapture(i, CJobScheduler::PRIORITY_CACHE_WARM);
     }
   }
+
+  // Labels pick up the new detail level on the next frame
+  damage();
 }
 
 void CHyprView::renderWorkspaceIndicator(size_t i, const CBox &borderBox,
                                          const CRegion &damage,
                                          const bool ISACTIVE) {
-  int workspaceID = images[i].originalWorkspace->m_id;
+  auto original = images[i].originalWorkspace.lock();
+  if (!original)
+    return;
+  int workspaceID = original->m_id;
   std::string workspaceText = "wsid:" + std::to_string(workspaceID);
   // Use border color based on whether window is active
   const auto &INDICATOR_COLOR =
-      ISACTIVE ? ACTIVE_BORDER_COLOR : INACTIVE_BORDER_COLOR;
+      ISACTIVE ? config->activeBorderColor : config->inactiveBorderColor;
   auto textTexture = g_pHyprOpenGL->renderText(workspaceText, INDICATOR_COLOR,
-                                               WORKSPACE_INDICATOR_FONT_SIZE,
+                                               config->workspaceIndicatorFontSize,
                                                false, "sans-serif");
 
   if (textTexture) {
@@ -1029,14 +2552,14 @@ void CHyprView::renderWorkspaceIndicator(size_t i, const CBox &borderBox,
     double textX, textY;
 
     // Calculate position based on configured position
-    if (WORKSPACE_INDICATOR_POSITION == "top-left") {
+    if (config->workspaceIndicatorPosition == INDICATOR_TOP_LEFT) {
       textX = borderBox.x + textPadding;
       textY = borderBox.y + textPadding;
-    } else if (WORKSPACE_INDICATOR_POSITION == "bottom-left") {
+    } else if (config->workspaceIndicatorPosition == INDICATOR_BOTTOM_LEFT) {
       textX = borderBox.x + textPadding;
       textY = borderBox.y + borderBox.height - (textTexture->m_size.y * 0.8) -
               textPadding;
-    } else if (WORKSPACE_INDICATOR_POSITION == "bottom-right") {
+    } else if (config->workspaceIndicatorPosition == INDICATOR_BOTTOM_RIGHT) {
       textX = borderBox.x + borderBox.width - (textTexture->m_size.x * 0.8) -
               textPadding;
       textY = borderBox.y + borderBox.height - (textTexture->m_size.y * 0.8) -
@@ -1058,7 +2581,7 @@ void CHyprView::renderWorkspaceIndicator(size_t i, const CBox &borderBox,
     CHyprOpenGLImpl::SRectRenderData bgData;
     bgData.round = 8;
     g_pHyprOpenGL->renderRect(
-        textBgBox, CHyprColor(0.0, 0.0, 0.0, WORKSPACE_INDICATOR_BG_OPACITY),
+        textBgBox, CHyprColor(0.0, 0.0, 0.0, config->workspaceIndicatorBgOpacity),
         bgData);
 
     // Render the text on top
@@ -1067,46 +2590,91 @@ void CHyprView::renderWorkspaceIndicator(size_t i, const CBox &borderBox,
   }
 }
 
-void CHyprView::renderWindowName(const SWindowImage &image,
-                                 const CBox &borderBox) {
+CHyprView::SWindowName CHyprView::windowNameFor(size_t i) const {
+  SWindowName name;
+  const auto &image = images[i];
   auto window = image.pWindow.lock();
-  if (!window)
-    return;
+  auto workspace = image.pWorkspace.lock();
+  if (!window && !workspace)
+    return name;
 
-  // Build separate strings for workspace ID and window info
-  std::string workspaceText;
-  std::string windowText = window->m_initialClass + " • " + window->m_title;
+  // Labels are shortened, then dropped, under frame-time pressure
+  const int DETAIL = quality.settings().labelDetail;
+  if (DETAIL <= 0)
+    return name;
 
-  // Determine workspace text color based on whether window is active
-  const auto PLASTWINDOW = g_pCompositor->m_lastWindow.lock();
-  const bool ISACTIVE = window == PLASTWINDOW;
-  const auto &WORKSPACE_COLOR = ISACTIVE ? ACTIVE_BORDER_COLOR : INACTIVE_BORDER_COLOR;
+  // Build separate strings for workspace ID and window info
+  if (!window)
+    name.windowText = "Workspace " + workspace->m_name;
+  else if (DETAIL >= 2)
+    name.windowText = window->m_initialClass + " • " + window->m_title;
+  else
+    name.windowText = window->m_initialClass;
 
   // Include workspace ID if workspace indicator is enabled
-  if (WORKSPACE_INDICATOR_ENABLED && image.originalWorkspace) {
-    workspaceText = "[" + std::to_string(image.originalWorkspace->m_id) + "] ";
+  auto original = image.originalWorkspace.lock();
+  if (DETAIL >= 2 && config->workspaceIndicatorEnabled && original) {
+    name.workspaceText = "[" + std::to_string(original->m_id) + "] ";
   }
 
-  // Render workspace text to get its width
-  SP<CTexture> workspaceTexture;
+  // Truncate against the final tile, not the animated one, so the label is
+  // rasterized once instead of on every animation frame
+  name.maxWidth = std::round(labelWidthForTile(i));
+  name.key = name.workspaceText + "\n" + name.windowText + "\n" +
+             std::to_string((int)name.maxWidth);
+  return name;
+}
+
+double CHyprView::labelWidthForTile(size_t i) const {
+  const auto &image = images[i];
+
+  // Same aspect fit as fullRender()
+  const Vector2D CONTENT =
+      image.pWorkspace ? pMonitor->m_pixelSize : image.originalSize;
+  if (CONTENT.x <= 0 || CONTENT.y <= 0)
+    return image.box.width + 2 * config->borderWidth;
+
+  const double FIT = std::min(image.box.width / CONTENT.x,
+                              image.box.height / CONTENT.y);
+  return CONTENT.x * FIT + 2 * config->borderWidth;
+}
+
+void CHyprView::rasterizeWindowName(size_t i) {
+  if (i >= images.size())
+    return;
+
+  auto &image = images[i];
+  const auto NAME = windowNameFor(i);
+  if (NAME.key.empty() || NAME.key == image.nameKey)
+    return;
+
+  std::string windowText = NAME.windowText;
+
+  // Both colors, so hovering does not need a new rasterization
+  image.activeWorkspaceNameTexture = nullptr;
+  image.inactiveWorkspaceNameTexture = nullptr;
   double workspaceWidth = 0.0;
-  if (!workspaceText.empty()) {
-    workspaceTexture = g_pHyprOpenGL->renderText(
-        workspaceText, WORKSPACE_COLOR, WINDOW_NAME_FONT_SIZE, false, "sans-serif");
-    if (workspaceTexture) {
-      workspaceWidth = workspaceTexture->m_size.x * 0.8;
+  if (!NAME.workspaceText.empty()) {
+    image.activeWorkspaceNameTexture =
+        g_pHyprOpenGL->renderText(NAME.workspaceText, config->activeBorderColor,
+                                  config->windowNameFontSize, false, "sans-serif");
+    image.inactiveWorkspaceNameTexture =
+        g_pHyprOpenGL->renderText(NAME.workspaceText, config->inactiveBorderColor,
+                                  config->windowNameFontSize, false, "sans-serif");
+    if (image.activeWorkspaceNameTexture) {
+      workspaceWidth = image.activeWorkspaceNameTexture->m_size.x * 0.8;
     }
   }
 
   // Calculate available width for the window text
   double bgPadding = 4.0;
-  double availableWidth = borderBox.width - workspaceWidth - (2 * bgPadding);
+  double availableWidth = NAME.maxWidth - workspaceWidth - (2 * bgPadding);
 
   // Helper function to truncate string with smart ellipsis
   auto truncateWithEllipsis = [&](const std::string &text, double maxWidth) -> std::string {
     // First check if truncation is needed
     auto fullTexture = g_pHyprOpenGL->renderText(
-        text, WINDOW_TEXT_COLOR, WINDOW_NAME_FONT_SIZE, false, "sans-serif");
+        text, config->windowTextColor, config->windowNameFontSize, false, "sans-serif");
     if (!fullTexture)
       return text;
 
@@ -1118,7 +2686,7 @@ void CHyprView::renderWindowName(const SWindowImage &image,
     // Use binary search approach with ellipsis " ... "
     std::string ellipsis = " ... ";
     auto ellipsisTexture = g_pHyprOpenGL->renderText(
-        ellipsis, WINDOW_TEXT_COLOR, WINDOW_NAME_FONT_SIZE, false, "sans-serif");
+        ellipsis, config->windowTextColor, config->windowNameFontSize, false, "sans-serif");
     double ellipsisWidth = ellipsisTexture ? ellipsisTexture->m_size.x * 0.8 : 30.0;
 
     // Reserve space for ellipsis
@@ -1140,7 +2708,7 @@ void CHyprView::renderWindowName(const SWindowImage &image,
                               text.substr(textLen - endChars);
 
       auto testTexture = g_pHyprOpenGL->renderText(
-          truncated, WINDOW_TEXT_COLOR, WINDOW_NAME_FONT_SIZE, false, "sans-serif");
+          truncated, config->windowTextColor, config->windowNameFontSize, false, "sans-serif");
       if (!testTexture)
         break;
 
@@ -1173,9 +2741,37 @@ void CHyprView::renderWindowName(const SWindowImage &image,
     windowText = truncateWithEllipsis(windowText, availableWidth);
   }
 
-  // Render window text
-  auto windowTexture = g_pHyprOpenGL->renderText(
-      windowText, WINDOW_TEXT_COLOR, WINDOW_NAME_FONT_SIZE, false, "sans-serif");
+  image.nameTexture = g_pHyprOpenGL->renderText(
+      windowText, config->windowTextColor, config->windowNameFontSize, false, "sans-serif");
+  image.nameKey = NAME.key;
+}
+
+void CHyprView::renderWindowName(size_t i, const CBox &borderBox) {
+  const auto &image = images[i];
+  const auto NAME = windowNameFor(i);
+  if (NAME.key.empty())
+    return;
+
+  // Stale or missing label: rasterize in the background, meanwhile keep
+  // showing the previous one
+  if (NAME.key != image.nameKey) {
+    jobs.schedule(CJobScheduler::JOB_WINDOW_NAME, i,
+                  CJobScheduler::PRIORITY_LABEL,
+                  [this, i] { rasterizeWindowName(i); });
+  }
+
+  // Determine workspace text color based on whether window is active
+  auto window = image.pWindow.lock();
+  const auto PLASTWINDOW = g_pCompositor->m_lastWindow.lock();
+  const bool ISACTIVE = window ? window == PLASTWINDOW
+                               : image.pWorkspace.lock() == pMonitor->m_activeWorkspace;
+
+  const auto &workspaceTexture = ISACTIVE ? image.activeWorkspaceNameTexture
+                                          : image.inactiveWorkspaceNameTexture;
+  const auto &windowTexture = image.nameTexture;
+  const double workspaceWidth =
+      workspaceTexture ? workspaceTexture->m_size.x * 0.8 : 0.0;
+  double bgPadding = 4.0;
 
   if (windowTexture) {
     double windowWidth = windowTexture->m_size.x * 0.8;
@@ -1196,7 +2792,7 @@ void CHyprView::renderWindowName(const SWindowImage &image,
     CHyprOpenGLImpl::SRectRenderData bgData;
     bgData.round = 4;
     g_pHyprOpenGL->renderRect(
-        textBgBox, CHyprColor(0.0, 0.0, 0.0, WINDOW_NAME_BG_OPACITY), bgData);
+        textBgBox, CHyprColor(0.0, 0.0, 0.0, config->windowNameBgOpacity), bgData);
 
     CRegion fakeDamage{0, 0, INT16_MAX, INT16_MAX};
 
@@ -1258,16 +2854,22 @@ int CHyprView::getWindowIndexFromMousePos(const Vector2D &mousePos) {
   if (images.empty())
     return -1;
 
+  // Tile boxes live on the (possibly scrolled) virtual canvas
+  const Vector2D canvasPos = toCanvas(mousePos);
+
   // Generic approach: iterate through all tiles and check if mouse is within
   // their boxes This works with ANY placement algorithm, not just grids The
   // placement algorithm has already calculated EXACT positions - we trust them
   // completely
   for (size_t i = 0; i < images.size(); ++i) {
+    if (images[i].filteredOut)
+      continue;
+
     const CBox &tileBox = images[i].box;
 
     // Check if mouse is within this tile's bounds
-    if (mousePos.x >= tileBox.x && mousePos.x <= tileBox.x + tileBox.width &&
-        mousePos.y >= tileBox.y && mousePos.y <= tileBox.y + tileBox.height) {
+    if (canvasPos.x >= tileBox.x && canvasPos.x <= tileBox.x + tileBox.width &&
+        canvasPos.y >= tileBox.y && canvasPos.y <= tileBox.y + tileBox.height) {
       return i;
     }
   }
@@ -1276,14 +2878,122 @@ int CHyprView::getWindowIndexFromMousePos(const Vector2D &mousePos) {
   return -1;
 }
 
+Vector2D CHyprView::toCanvas(const Vector2D &localPos) const {
+  return localPos + Vector2D{0.0, scrollOffset ? scrollOffset->value() : 0.0};
+}
+
 bool CHyprView::isMouseOverValidTile(const Vector2D &mousePos) {
   return getWindowIndexFromMousePos(mousePos) != -1;
 }
 
+void CHyprView::writeDebugInfo(std::ostream &out) const {
+  auto monitor = pMonitor.lock();
+  out << "Instance: " << (monitor ? monitor->m_name : "<gone>") << "\n";
+  out << "  Placement: " << m_placement << "\n";
+  out << "  Tiles: " << images.size() << "\n";
+
+  size_t allocated = 0;
+  size_t atlased = 0;
+  size_t evicted = 0;
+  for (const auto &image : images) {
+    if (image.atlasSlot)
+      atlased++;
+    else if (image.fb.m_size.x > 0)
+      allocated++;
+    if (image.evicted)
+      evicted++;
+  }
+  out << "  Framebuffers: " << allocated << "/" << images.size() << ", "
+      << atlased << " in atlas, " << evicted << " evicted\n";
+
+  constexpr double MB = 1024.0 * 1024.0;
+  const auto VRAM = vramUsage();
+  out << "  VRAM: " << VRAM.total() / MB
+      << "MB (thumbnails=" << VRAM.thumbnails / MB
+      << "MB atlas=" << VRAM.atlas / MB
+      << "MB full resolution=" << VRAM.hiRes / MB
+      << "MB background=" << VRAM.background / MB << "MB)\n";
+  if (thumbnailVramScale < 1.0)
+    out << "  VRAM budget scale: " << thumbnailVramScale << "\n";
+  if (atlasPacker) {
+    out << "  Atlas pages:";
+    for (size_t page = 0; page < atlasPages.size(); ++page)
+      out << " " << (int)(atlasPacker->occupancy(page) * 100) << "%";
+    out << " (repacks " << atlasRepacks << ")\n";
+  }
+  if (sharedCaptures > 0)
+    out << "  Thumbnails copied from other overviews: " << sharedCaptures
+        << "\n";
+  if (hiResIndex >= 0) {
+    out << "  Full resolution tile: " << hiResIndex << " (" << hiResFb.m_size.x
+        << "x" << hiResFb.m_size.y << ")\n";
+  }
+  out << "  Sections: " << sections.size() << "\n";
+
+  // Achieved refresh rate per tile since the overview opened
+  const double ELAPSED =
+      std::chrono::duration<double>(Time::steadyNow() - openedAt).count();
+  out << "  Tile refresh:\n";
+  for (size_t i = 0; i < images.size(); ++i) {
+    const auto &image = images[i];
+    auto window = image.pWindow.lock();
+    const std::string NAME =
+        window ? window->m_initialClass
+               : (image.pWorkspace ? "workspace " + image.pWorkspace.lock()->m_name
+                                   : "<gone>");
+    const size_t REFRESHES = image.redrawCount;
+    out << "    [" << i << "] " << NAME
+        << ": policy=" << refreshPolicyToString(image.refreshPolicy)
+        << " profile=" << thumbnailProfileToString(image.renderProfile)
+        << " redraws=" << REFRESHES << " achieved="
+        << (ELAPSED > 0.0 ? REFRESHES / ELAPSED : 0.0) << "fps\n";
+  }
+  out << "  Quality: level " << quality.level() << "/"
+      << CQualityController::MAX_LEVEL
+      << " (resolution=" << quality.settings().resolutionScale
+      << " refresh cap=" << quality.settings().maxRefreshFps
+      << "fps label detail=" << quality.settings().labelDetail << ")\n";
+  out << "  GPU frame time: p50=" << quality.percentile(0.5)
+      << "ms p95=" << quality.percentile(0.95)
+      << "ms p99=" << quality.percentile(0.99)
+      << "ms, redraws p95=" << quality.redrawPercentile(0.95) << "ms over "
+      << quality.sampleCount() << " frames (" << quality.totalSamples()
+      << " total), interval="
+      << (pMonitor->m_refreshRate > 0 ? 1000.0 / pMonitor->m_refreshRate
+                                      : 0.0)
+      << "ms" << (gpuTimer.supported() ? "" : ", timer queries unsupported")
+      << "\n";
+  out << "  Jobs: pending=" << jobs.pending()
+      << " executed=" << jobs.executed()
+      << " carried over=" << jobs.carriedOver()
+      << " last drain=" << jobs.lastDrainMs()
+      << "ms max drain=" << jobs.maxDrainMs() << "ms\n";
+  out << "  Pointer motion: " << pointerEvents << " events, "
+      << pointerHitTests << " hit tests\n";
+  out << "  Filter: '" << filterQuery << "' " << filterVisible << "/"
+      << images.size() << " tiles ("
+      << (searchIndex.lastWasFuzzy() ? "fuzzy, " : "")
+      << searchIndex.lastCompared() << " texts compared)\n";
+  out << "  Canvas height: " << canvasHeight << " (scroll "
+      << (scrollOffset ? scrollOffset->value() : 0.f) << ")\n";
+  out << "  Closing: " << (closing ? "yes" : "no") << "\n";
+
+  if (!m_placementScores.empty()) {
+    out << "  Auto placement candidates:\n";
+    for (const auto &score : m_placementScores) {
+      out << "    " << score.name << ": score=" << score.score
+          << " utilization=" << score.utilization
+          << " minScale=" << score.minScale << " time=" << score.elapsedMs
+          << "ms" << (score.completed ? "" : " (over budget)") << "\n";
+    }
+  }
+}
+
 void CHyprView::updateHoverState(int newIndex) {
   // Update visual hover state immediately for responsiveness
   if (newIndex != visualHoveredIndex) {
     visualHoveredIndex = newIndex;
+    setHiResTile(newIndex);
     // Trigger immediate visual update without waiting for focus change
     damage();
   }
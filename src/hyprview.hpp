@@ -1,11 +1,22 @@
 #pragma once
 #define WLR_USE_UNSTABLE
 
+#include "AtlasPacker.hpp"
+#include "ConfigSnapshot.hpp"
+#include "GpuTimer.hpp"
+#include "JobScheduler.hpp"
+#include "PlacementAlgorithms.hpp"
+#include "QualityController.hpp"
+#include "WindowSearch.hpp"
+#include "WindowRules.hpp"
 #include "globals.hpp"
 #include <hyprland/src/desktop/DesktopTypes.hpp>
 #include <hyprland/src/helpers/AnimatedVariable.hpp>
+#include <hyprland/src/helpers/time/Time.hpp>
 #include <hyprland/src/managers/HookSystemManager.hpp>
 #include <hyprland/src/render/Framebuffer.hpp>
+#include <any>
+#include <iosfwd>
 #include <unordered_map>
 #include <vector>
 
@@ -22,29 +33,29 @@ enum class EWindowCollectionMode {
   CURRENT_ONLY,    // Default: only current workspace windows
   ALL_WORKSPACES,  // All workspaces on monitor (excluding special)
   WITH_SPECIAL,    // Current workspace + special workspace
-  ALL_WITH_SPECIAL // All workspaces + special workspace
+  ALL_WITH_SPECIAL, // All workspaces + special workspace
+  WORKSPACES,       // One tile per workspace on the monitor (no windows)
+  GLOBAL            // Visible windows of every monitor, arranged like them
 };
 
 class CMonitor;
-class CHyprView;
-
-// Forward declare friend functions
-CHyprView *findInstanceForAnimation(
-    WP<Hyprutils::Animation::CBaseAnimatedVariable> thisptr);
-
-// Function declaration for damageMonitor used by placement algorithms
-void damageMonitor(WP<Hyprutils::Animation::CBaseAnimatedVariable> thisptr);
 
 class CHyprView {
 public:
   CHyprView(PHLMONITOR pMonitor_, PHLWORKSPACE startedOn_, bool swipe = false,
             EWindowCollectionMode mode = EWindowCollectionMode::CURRENT_ONLY,
-            const std::string &placement = "grid", bool explicitOn = false);
+            const std::string &placement = "grid", bool explicitOn = false,
+            bool deferBackground = false);
   ~CHyprView();
 
   void render();
   void damage();
-  void onDamageReported();
+  // source: window whose surface commit caused the damage, if known
+  void onDamageReported(const CBox &damageBox, const PHLWINDOW &source);
+  // Damage on another monitor (box in its pixel coordinates), marks the
+  // tiles of the windows it touches dirty (global)
+  void onForeignDamage(const PHLMONITOR &monitor, const CBox &damageBox,
+                       const PHLWINDOW &source);
   void onPreRender();
 
   void setClosing(bool closing);
@@ -55,13 +66,78 @@ public:
 
   // close without a selection
   void close();
+  // Once the close animation is done: releases resources, or with resident
+  // only what a dormant instance does not keep (hooks, timers, hiResFb)
+  void finishClose();
+  // Wakes up a dormant instance or turns a closing one around. False if the
+  // monitor or the window set changed since it was built, a new instance is
+  // needed then.
+  bool reopen(PHLWORKSPACE startedOn_, bool swipe_, EWindowCollectionMode mode,
+              const std::string &placement, bool explicitOn,
+              bool deferBackground);
   void selectHoveredWindow();
+  // Starts an instance opened held at scale 0 (see openHyprViews()), running
+  // a deferred background capture and queued captures within captureBudgetMs
+  // first
+  void startOpen(double captureBudgetMs);
 
   // Accurate mouse-to-tile calculation
   int getWindowIndexFromMousePos(const Vector2D &mousePos);
   bool isMouseOverValidTile(const Vector2D &mousePos);
   void updateHoverState(int newIndex);
 
+  // Pointer and touch input routed to this monitor's instance by
+  // g_inputRouter, localPos relative to the monitor
+  // Motion only records the position, the hit test runs once per frame in
+  // onPreRender()
+  void onPointerMove(const Vector2D &localPos, SCallbackInfo &info);
+  void onPointerButton(const Vector2D &localPos, SCallbackInfo &info);
+  void onPointerAxis(const Vector2D &localPos, SCallbackInfo &info,
+                     std::any param);
+  // Typing filters the tiles (not in sticky mode), see applyFilter()
+  void onKey(SCallbackInfo &info, std::any param);
+  void onWindowTitleChanged(const PHLWINDOW &window);
+
+  // Dump instance state for the debug dispatcher
+  void writeDebugInfo(std::ostream &out) const;
+
+  // Framebuffer memory held by this instance, in bytes
+  struct SVramUsage {
+    size_t thumbnails = 0;
+    size_t atlas = 0;
+    size_t hiRes = 0;
+    size_t background = 0;
+
+    size_t total() const { return thumbnails + atlas + hiRes + background; }
+  };
+
+  SVramUsage vramUsage() const;
+
+  // Thumbnail the VRAM budget may evict: an own framebuffer of a tile that is
+  // off screen
+  struct SEvictionCandidate {
+    size_t tile = 0;
+    Time::steady_tp lastVisible;
+    size_t bytes = 0;
+  };
+
+  std::vector<SEvictionCandidate> evictionCandidates() const;
+  void evictThumbnail(size_t id);
+  // Halves (or doubles back) the capture size of all thumbnails and queues
+  // the recaptures. False if already at the limit.
+  bool scaleThumbnails(bool down);
+  double vramScale() const { return thumbnailVramScale; }
+
+  // Up to date thumbnail of a window for another instance to copy instead of
+  // rendering the window again: the texture and the part of it holding the
+  // window (all of it unless atlased)
+  struct SSharedThumbnail {
+    SP<CTexture> texture;
+    CBox source;
+  };
+
+  std::optional<SSharedThumbnail> sharedThumbnail(const PHLWINDOW &window) const;
+
   bool blockOverviewRendering = false;
   bool blockDamageReporting = false;
 
@@ -71,41 +147,36 @@ public:
   bool swipe = false;
   bool stickyOn = false;        // True if turned on with :on command (sticky mode)
   bool readyForCleanup = false; // True when safe to remove from render pass
+  bool resident = false;        // Kept dormant after close (resident)
 
 private:
   void redrawID(int id, bool forcelowres = false);
   void redrawAll(bool forcelowres = false);
+  void refreshDirtyTiles();
+  void scheduleTileCapture(size_t id, CJobScheduler::ePriority priority);
+  void runJobs();
+  void recordFrameCost(const CGpuTimer::SFrameTimes &times);
+  bool isTileInViewport(size_t id, bool prefetch = true) const;
+  void updateVirtualizedTiles();
+  void scrollBy(double delta);
+  Vector2D toCanvas(const Vector2D &localPos) const;
   void onWorkspaceChange();
   void fullRender();
   void renderWorkspaceIndicator(size_t i, const CBox &borderBox,
                                 const CRegion &damage, const bool ISACTIVE);
   void captureBackground();
+  std::vector<PHLWORKSPACE> collectWorkspaces() const;
+  std::vector<PHLWINDOW> collectWindows(const PHLWORKSPACE &activeWorkspace) const;
   void setupWindowImages(std::vector<PHLWINDOW> &windowsToRender);
+  void resolveTileRules();
+  void createRefreshTimer();
+  void flushPointerMotion();
 
   CFramebuffer bgFramebuffer; // Store the captured background
   bool bgCaptured = false;    // Flag to track if background is captured
 
-  int MARGIN = 15; // Margin around each grid tile
-
-  CHyprColor ACTIVE_BORDER_COLOR;
-  CHyprColor INACTIVE_BORDER_COLOR;
-  int BORDER_WIDTH;
-  int BORDER_RADIUS;
-  float BG_DIM;
-
-  // Workspace indicator configuration
-  bool WORKSPACE_INDICATOR_ENABLED;
-  int WORKSPACE_INDICATOR_FONT_SIZE;
-  std::string WORKSPACE_INDICATOR_POSITION;
-  float WORKSPACE_INDICATOR_BG_OPACITY;
-
-  // Window name configuration
-  bool WINDOW_NAME_ENABLED;
-  int WINDOW_NAME_FONT_SIZE;
-  float WINDOW_NAME_BG_OPACITY;
-  CHyprColor WINDOW_TEXT_COLOR;
-
-  bool damageDirty = false;
+  // Config snapshot taken at construction (ConfigSnapshot.hpp)
+  SP<const SHyprViewConfig> config;
 
   struct SWindowImage {
     CFramebuffer fb;
@@ -113,12 +184,90 @@ private:
     CBox box;
     Vector2D originalPos;
     Vector2D originalSize;
-    PHLWORKSPACE originalWorkspace; // Store original workspace for restoration
+    PHLWORKSPACEREF originalWorkspace; // Store original workspace for restoration
+    PHLWORKSPACEREF pWorkspace;        // Set for workspace thumbnail tiles
+    bool dirty = false;             // Reported damage, waiting for a redraw
+    SRefreshPolicy refreshPolicy;   // How often a dirty tile may be redrawn
+    eThumbnailProfile renderProfile = PROFILE_SURFACE;
+    Time::steady_tp lastRedraw;     // Last capture of this tile
+    size_t redrawCount = 0;         // Damage driven redraws since open
+    bool lowResStale = false;       // Only the full resolution one refreshed
+    std::optional<SAtlasSlot> atlasSlot; // Set instead of fb in atlas mode
+    bool atlasPending = false;      // Slot moved by a repack, not recaptured
+    Time::steady_tp lastVisible;    // Last frame the tile was on screen
+    bool evicted = false;           // Released by the VRAM budget
+    bool filteredOut = false;       // Hidden by the type-to-filter query
+    CBox unfilteredBox;             // Placement before filtering started
+
+    // Label textures, rasterized by a job whenever nameKey goes stale
+    SP<CTexture> nameTexture;
+    SP<CTexture> activeWorkspaceNameTexture;
+    SP<CTexture> inactiveWorkspaceNameTexture;
+    std::string nameKey;
   };
 
-  void renderWindowName(const SWindowImage &image, const CBox &borderBox);
+  // Label content of a tile, key changes whenever it must be re-rasterized
+  struct SWindowName {
+    std::string workspaceText;
+    std::string windowText;
+    double maxWidth = 0.0;
+    std::string key;
+  };
+
+  SWindowName windowNameFor(size_t i) const;
+  double labelWidthForTile(size_t i) const;
+  void rasterizeWindowName(size_t i);
+  void renderWindowName(size_t i, const CBox &borderBox);
+  double captureScale(const SWindowImage &image, const Vector2D &source,
+                      bool fullResolution) const;
+  void captureWindowImage(SWindowImage &image, bool fullResolution = false);
+  bool copySharedThumbnail(SWindowImage &image, const PHLWINDOW &window,
+                           const Vector2D &size);
+  void captureWorkspaceImage(SWindowImage &image, bool fullResolution);
+  void setHiResTile(int index);
+
+  // Where a capture is rendered to: an atlas slot or a framebuffer of its own
+  struct SCaptureTarget {
+    CFramebuffer *fb = nullptr;
+    CBox box;
+    bool atlas = false;
+  };
+
+  SCaptureTarget prepareCaptureTarget(SWindowImage &image,
+                                      const Vector2D &size,
+                                      bool fullResolution);
+  bool ensureAtlasSlot(SWindowImage &image, const Vector2D &size);
+  void repackAtlas();
+  bool hasThumbnail(const SWindowImage &image) const;
+  uint32_t thumbnailFormat() const;
+  void releaseThumbnail(SWindowImage &image);
+  void updateMipmaps(CFramebuffer &fb, const SWindowImage &image);
+  void placeTiles(const std::vector<WindowInfo> &windowInfos, size_t first,
+                  size_t last, const ScreenInfo &area,
+                  const std::vector<size_t> *tileIds = nullptr);
+  std::string searchTextFor(size_t i) const;
+  void buildSearchIndex();
+  void applyFilter();
+  void restoreUnfilteredLayout();
+  void renderFilterLabel();
+  void renderSectionHeaders(float alpha);
+
+  // One section per workspace when grouping is enabled (empty otherwise)
+  struct SWorkspaceSection {
+    PHLWORKSPACEREF workspace;
+    CBox header;           // Header strip on the canvas
+    size_t firstTile = 0;  // First index into images
+    size_t tileCount = 0;  // Number of tiles in the section
+    SP<CTexture> headerTexture; // Rasterized once, by a job
+    PHLMONITORREF monitor; // Global mode: the header shows the monitor name
+  };
+
+  std::vector<SWorkspaceSection> sections;
 
   Vector2D lastMousePosLocal = Vector2D{};
+  bool pointerMotionPending = false; // Moved since the last hit test
+  size_t pointerEvents = 0;          // Motion events received since open
+  size_t pointerHitTests = 0;        // Hit tests they were coalesced into
 
   int openedID = -1;
   int closeOnID = -1;
@@ -127,31 +276,91 @@ private:
 
   std::vector<SWindowImage> images;
 
+  // Full resolution capture of the hovered tile, the others stay at
+  // thumbnail size
+  CFramebuffer hiResFb;
+  int hiResIndex = -1;
+
+  // Thumbnail atlas (thumbnail_atlas), created on first use
+  std::optional<CShelfPacker> atlasPacker;
+  std::vector<UP<CFramebuffer>> atlasPages;
+  size_t atlasRepacks = 0;
+  size_t sharedCaptures = 0; // Thumbnails copied from another instance
+
+  // Thumbnail capture factor set by the VRAM budget (vram_budget_mb)
+  double thumbnailVramScale = 1.0;
+
   PHLWINDOWREF originalFocusedWindow;  // Window that had focus before overview
   bool userExplicitlySelected = false; // Whether user clicked/selected a window
   PHLWINDOWREF lastHoveredWindow;      // Track last hovered window for focus
 
-  PHLWORKSPACE startedOn;
+  PHLWORKSPACEREF startedOn;
   EWindowCollectionMode m_collectionMode;
   std::string m_placement;
+  std::vector<PlacementScore> m_placementScores; // Filled by "auto" placement
 
   PHLANIMVAR<Vector2D> size;
   PHLANIMVAR<Vector2D> pos;
   PHLANIMVAR<float> scale; // Scale animation for overview
+  PHLANIMVAR<float> scrollOffset; // Vertical scroll of the virtual canvas
 
-  SP<HOOK_CALLBACK_FN> mouseMoveHook;
-  SP<HOOK_CALLBACK_FN> mouseButtonHook;
-  SP<HOOK_CALLBACK_FN> mouseAxisHook;
-  SP<HOOK_CALLBACK_FN> touchMoveHook;
-  SP<HOOK_CALLBACK_FN> touchDownHook;
+  double canvasHeight = 0.0; // Height of all pages (monitor height if one page)
+
+  // Type-to-filter: the survivors are placed again on the area the
+  // constructor placed all tiles on, keeping their thumbnails
+  CWindowSearchIndex searchIndex;
+  std::string filterQuery;
+  ScreenInfo filterArea = {};
+  double unfilteredCanvasHeight = 0.0;
+  size_t filterVisible = 0; // Tiles matching filterQuery
+  SP<CTexture> filterTexture;
+  std::string filterTextureKey;
 
   bool swipeWasCommenced = false;
 
+  wl_event_source *refreshTimer = nullptr; // Wakes up rate limited tiles
+  Time::steady_tp openedAt;
+
+  // Deferred captures and rasterization, drained within the frame budget
+  CJobScheduler jobs;
+  wl_event_source *idleSource = nullptr; // Drains leftovers when idle
+
+  // Steps thumbnail quality down when frames get too expensive, fed with
+  // the GPU time of fullRender() and the job drains
+  CQualityController quality;
+  CGpuTimer gpuTimer;
+
+  // Pass elements hold a weak copy, it expires when the instance is gone
+  SP<CHyprView *> selfHandle = makeShared<CHyprView *>(this);
+
   friend class CHyprViewPassElement;
-  friend CHyprView * ::findInstanceForAnimation(
-      WP<Hyprutils::Animation::CBaseAnimatedVariable>);
 };
 
 // Map of monitor to CHyprView instance - one overview per monitor
 inline std::unordered_map<PHLMONITOR, std::unique_ptr<CHyprView>>
     g_pHyprViewInstances;
+
+// Closed instances kept for the next open of their monitor (resident)
+inline std::unordered_map<PHLMONITOR, std::unique_ptr<CHyprView>>
+    g_pHyprViewDormant;
+
+// Reopens the monitor's closing or dormant instance if it is still valid,
+// builds a new one otherwise. Assign the result to g_pHyprViewInstances.
+// deferBackground leaves the background capture to startOpen().
+std::unique_ptr<CHyprView>
+openHyprView(PHLMONITOR monitor, PHLWORKSPACE startedOn, bool swipe,
+             EWindowCollectionMode mode, const std::string &placement,
+             bool explicitOn = false, bool deferBackground = false);
+
+// Opens the overviews of several monitors as one batch: all are built (or
+// reopened) first, then their backgrounds and first captures run in one pass
+// under one EGL context, the captures sharing one frame budget, and every
+// open animation starts on the same frame. Monitors already showing an open
+// overview must be filtered out by the caller.
+void openHyprViews(const std::vector<PHLMONITOR> &monitors,
+                   EWindowCollectionMode mode, const std::string &placement,
+                   bool explicitOn = false);
+
+// Takes a closed instance out of service: dormant with resident, destroyed
+// otherwise
+void retireHyprView(PHLMONITOR monitor, std::unique_ptr<CHyprView> instance);
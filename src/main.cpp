@@ -1,7 +1,14 @@
 #define WLR_USE_UNSTABLE
 
+#include "ConfigSnapshot.hpp"
+#include "FocusHistory.hpp"
+#include "InputRouter.hpp"
 #include "PlacementAlgorithms.hpp"
+#include "PlacementCache.hpp"
+#include "Switcher.hpp"
 #include "ViewGesture.hpp"
+#include "VramBudget.hpp"
+#include "WindowRules.hpp"
 #include "globals.hpp"
 #include "hyprview.hpp"
 #include <fstream>
@@ -9,6 +16,9 @@
 #include <hyprland/src/config/ConfigManager.hpp>
 #include <hyprland/src/debug/Log.hpp>
 #include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprland/src/desktop/Popup.hpp>
+#include <hyprland/src/desktop/Subsurface.hpp>
+#include <hyprland/src/desktop/WLSurface.hpp>
 #include <hyprland/src/desktop/Window.hpp>
 #include <hyprland/src/managers/input/trackpad/GestureTypes.hpp>
 #include <hyprland/src/managers/input/trackpad/TrackpadGestures.hpp>
@@ -22,13 +32,20 @@ using namespace Hyprutils::String;
 inline CFunctionHook *g_pRenderWorkspaceHook = nullptr;
 inline CFunctionHook *g_pAddDamageHookA = nullptr;
 inline CFunctionHook *g_pAddDamageHookB = nullptr;
+inline CFunctionHook *g_pDamageSurfaceHook = nullptr;
 typedef void (*origRenderWorkspace)(void *, PHLMONITOR, PHLWORKSPACE,
                                     timespec *, const CBox &);
 typedef void (*origAddDamageA)(void *, const CBox &);
 typedef void (*origAddDamageB)(void *, const pixman_region32_t *);
+typedef void (*origDamageSurface)(void *, SP<CWLSurfaceResource>, double,
+                                  double, double);
 
 static bool g_unloading = false;
 
+// Window whose surface commit is being damaged, so the damage hooks know
+// where damage came from. Unset for layer surfaces, the cursor, etc.
+static PHLWINDOWREF g_damageSource;
+
 // Do NOT change this function.
 APICALL EXPORT std::string PLUGIN_API_VERSION() { return HYPRLAND_API_VERSION; }
 
@@ -55,6 +72,50 @@ static void hkRenderWorkspace(void *thisptr, PHLMONITOR pMonitor,
   }
 }
 
+static PHLWINDOW windowFromSurface(const SP<CWLSurfaceResource> &surface) {
+  const auto HLSURFACE = CWLSurface::fromResource(surface);
+  if (!HLSURFACE)
+    return nullptr;
+
+  if (auto window = HLSURFACE->getWindow())
+    return window;
+  if (auto *subsurface = HLSURFACE->getSubsurface())
+    return subsurface->m_windowParent.lock();
+  if (auto *popup = HLSURFACE->getPopup())
+    return popup->m_windowOwner.lock();
+  return nullptr;
+}
+
+static void hkDamageSurface(void *thisptr, SP<CWLSurfaceResource> surface,
+                            double x, double y, double scale) {
+  if (g_pHyprViewInstances.empty()) {
+    ((origDamageSurface)g_pDamageSurfaceHook->m_original)(thisptr, surface, x,
+                                                          y, scale);
+    return;
+  }
+
+  const auto PREVIOUS = g_damageSource;
+  g_damageSource = windowFromSurface(surface);
+  ((origDamageSurface)g_pDamageSurfaceHook->m_original)(thisptr, surface, x, y,
+                                                        scale);
+  g_damageSource = PREVIOUS;
+}
+
+// Global overviews show windows of other monitors, their damage is passed on.
+// Not the damage an overview reports for its own redraw.
+// box in the damaged monitor's pixel coordinates
+static void forwardForeignDamage(const PHLMONITOR &monitor, const CBox &box) {
+  auto it = g_pHyprViewInstances.find(monitor);
+  if (it != g_pHyprViewInstances.end() && it->second &&
+      it->second->blockDamageReporting)
+    return;
+
+  for (auto &[other, instance] : g_pHyprViewInstances) {
+    if (instance && other != monitor)
+      instance->onForeignDamage(monitor, box, g_damageSource.lock());
+  }
+}
+
 static void hkAddDamageA(void *thisptr, const CBox &box) {
   const auto PMONITOR = (CMonitor *)thisptr;
   const auto PMONITORSP = PMONITOR->m_self.lock();
@@ -64,6 +125,8 @@ static void hkAddDamageA(void *thisptr, const CBox &box) {
     return;
   }
 
+  forwardForeignDamage(PMONITORSP, box);
+
   auto it = g_pHyprViewInstances.find(PMONITORSP);
   if (it == g_pHyprViewInstances.end() || !it->second ||
       it->second->blockDamageReporting) {
@@ -71,7 +134,7 @@ static void hkAddDamageA(void *thisptr, const CBox &box) {
     return;
   }
 
-  it->second->onDamageReported();
+  it->second->onDamageReported(box, g_damageSource.lock());
 }
 
 static void hkAddDamageB(void *thisptr, const pixman_region32_t *rg) {
@@ -83,6 +146,13 @@ static void hkAddDamageB(void *thisptr, const pixman_region32_t *rg) {
     return;
   }
 
+  const auto EXTENTS = pixman_region32_extents(rg);
+  const CBox BOX = {(double)EXTENTS->x1, (double)EXTENTS->y1,
+                    (double)(EXTENTS->x2 - EXTENTS->x1),
+                    (double)(EXTENTS->y2 - EXTENTS->y1)};
+
+  forwardForeignDamage(PMONITORSP, BOX);
+
   auto it = g_pHyprViewInstances.find(PMONITORSP);
   if (it == g_pHyprViewInstances.end() || !it->second ||
       it->second->blockDamageReporting) {
@@ -90,7 +160,7 @@ static void hkAddDamageB(void *thisptr, const pixman_region32_t *rg) {
     return;
   }
 
-  it->second->onDamageReported();
+  it->second->onDamageReported(BOX, g_damageSource.lock());
 }
 
 // Helper function to parse dispatcher arguments
@@ -99,8 +169,10 @@ struct DispatcherArgs {
                       ON,
                       OFF,
                       SELECT,
+                      SWITCHER,
                       DEBUG } action;
   EWindowCollectionMode collectionMode;
+  bool reverse = false; // Switcher: cycle backwards
   std::string placement;
   std::string
       targetMonitor; // Empty = current monitor, otherwise specific monitor name
@@ -123,6 +195,9 @@ static DispatcherArgs parseDispatcherArgs(const std::string &arg) {
     result.action = DispatcherArgs::Action::DEBUG;
   } else if (lowerArg == "select") {
     result.action = DispatcherArgs::Action::SELECT;
+  } else if (lowerArg.find("switcher") != std::string::npos) {
+    result.action = DispatcherArgs::Action::SWITCHER;
+    result.reverse = lowerArg.find("reverse") != std::string::npos;
   } else if (lowerArg.find("off") != std::string::npos) {
     result.action = DispatcherArgs::Action::OFF;
   } else if (lowerArg.find("on") != std::string::npos) {
@@ -136,7 +211,11 @@ static DispatcherArgs parseDispatcherArgs(const std::string &arg) {
   bool hasSpecial = (lowerArg.find("special") != std::string::npos);
 
   // Determine collection mode
-  if (hasAll && hasSpecial) {
+  if (lowerArg.find("workspaces") != std::string::npos) {
+    result.collectionMode = EWindowCollectionMode::WORKSPACES;
+  } else if (lowerArg.find("global") != std::string::npos) {
+    result.collectionMode = EWindowCollectionMode::GLOBAL;
+  } else if (hasAll && hasSpecial) {
     result.collectionMode = EWindowCollectionMode::ALL_WITH_SPECIAL;
   } else if (hasAll) {
     result.collectionMode = EWindowCollectionMode::ALL_WORKSPACES;
@@ -157,13 +236,11 @@ static DispatcherArgs parseDispatcherArgs(const std::string &arg) {
     result.placement = lowerArg.substr(start, end - start);
 
     // Validate placement algorithm
-    if (!result.placement.empty() && result.placement != "grid" &&
-        result.placement != "spiral" && result.placement != "flow" &&
-        result.placement != "adaptive" && result.placement != "wide" &&
-        result.placement != "scale") {
+    if (!result.placement.empty() && result.placement != "auto" &&
+        !findPlacementAlgorithm(result.placement)) {
       result.error =
           "Invalid placement algorithm: " + result.placement +
-          ". Valid options: grid, spiral, flow, adaptive, wide, scale";
+          ". Valid options: grid, spiral, flow, adaptive, wide, scale, auto";
     }
   }
 
@@ -184,10 +261,17 @@ static DispatcherArgs parseDispatcherArgs(const std::string &arg) {
 
 // Helper to get target monitor(s)
 static std::vector<PHLMONITOR>
-getTargetMonitors(const std::string &targetMonitorName) {
+getTargetMonitors(const std::string &targetMonitorName,
+                  EWindowCollectionMode mode) {
   std::vector<PHLMONITOR> targets;
 
-  if (targetMonitorName.empty()) {
+  if (targetMonitorName.empty() && mode == EWindowCollectionMode::GLOBAL) {
+    // A global overview already shows every monitor, open it where the user
+    // is looking
+    auto monitor = g_pCompositor->m_lastMonitor.lock();
+    if (monitor && monitor->m_enabled && monitor->m_activeWorkspace)
+      targets.push_back(monitor);
+  } else if (targetMonitorName.empty()) {
     // No specific monitor - use ALL enabled monitors
     for (auto &monitor : g_pCompositor->m_monitors) {
       if (monitor->m_enabled && monitor->m_activeWorkspace) {
@@ -230,6 +314,11 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
 
   // Handle SELECT action
   if (parsedArgs.action == DispatcherArgs::Action::SELECT) {
+    if (g_pSwitcher && !g_pSwitcher->done) {
+      g_pSwitcher->commit();
+      return {};
+    }
+
     auto PMONITOR = g_pCompositor->m_lastMonitor.lock();
     if (PMONITOR) {
       auto it = g_pHyprViewInstances.find(PMONITOR);
@@ -241,6 +330,21 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
     return {};
   }
 
+  // Handle SWITCHER action: open, or cycle an open one
+  if (parsedArgs.action == DispatcherArgs::Action::SWITCHER) {
+    if (g_pSwitcher && !g_pSwitcher->done) {
+      g_pSwitcher->cycle(parsedArgs.reverse);
+      return {};
+    }
+
+    auto PMONITOR = g_pCompositor->m_lastMonitor.lock();
+    if (!PMONITOR)
+      return {.success = false, .error = "No active monitor"};
+
+    g_pSwitcher = std::make_unique<CSwitcher>(PMONITOR, parsedArgs.reverse);
+    return {};
+  }
+
   // Handle DEBUG action
   if (parsedArgs.action == DispatcherArgs::Action::DEBUG) {
     auto PMONITOR = g_pCompositor->m_lastMonitor.lock();
@@ -293,7 +397,10 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
         return false;
 
       auto windowMonitor = w->m_monitor.lock();
-      if (!windowMonitor || windowMonitor != PMONITOR)
+      if (!windowMonitor)
+        return false;
+      if (parsedArgs.collectionMode != EWindowCollectionMode::GLOBAL &&
+          windowMonitor != PMONITOR)
         return false;
 
       switch (parsedArgs.collectionMode) {
@@ -306,6 +413,10 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
                windowWorkspace->m_isSpecialWorkspace;
       case EWindowCollectionMode::ALL_WITH_SPECIAL:
         return true;
+      case EWindowCollectionMode::WORKSPACES:
+        return false;
+      case EWindowCollectionMode::GLOBAL:
+        return windowWorkspace == windowMonitor->m_activeWorkspace;
       }
       return false;
     };
@@ -334,32 +445,23 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
     }
 
     // Get margin from config
-    static auto *const *PMARGIN =
-        (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-            PHANDLE, "plugin:hyprview:margin")
-            ->getDataStaticPtr();
-    int margin = **PMARGIN;
+    int margin = hyprViewConfig()->margin;
 
     // Prepare screen info
     ScreenInfo screenInfo = {availableSize.x, availableSize.y,
                              reservedTopLeft.x, reservedTopLeft.y,
                              (double)margin};
 
+    static auto *const *PAUTOBUDGET =
+        (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
+            PHANDLE, "plugin:hyprview:auto_placement_budget_ms")
+            ->getDataStaticPtr();
+
     // Call placement algorithm
-    PlacementResult placementResult;
-    if (parsedArgs.placement == "spiral") {
-      placementResult = spiralPlacement(windowInfos, screenInfo);
-    } else if (parsedArgs.placement == "flow") {
-      placementResult = flowPlacement(windowInfos, screenInfo);
-    } else if (parsedArgs.placement == "adaptive") {
-      placementResult = adaptivePlacement(windowInfos, screenInfo);
-    } else if (parsedArgs.placement == "wide") {
-      placementResult = widePlacement(windowInfos, screenInfo);
-    } else if (parsedArgs.placement == "scale") {
-      placementResult = scalePlacement(windowInfos, screenInfo);
-    } else {
-      placementResult = gridPlacement(windowInfos, screenInfo);
-    }
+    std::vector<PlacementScore> placementScores;
+    PlacementResult placementResult =
+        runPlacement(parsedArgs.placement, windowInfos, screenInfo,
+                     (double)**PAUTOBUDGET, &placementScores);
 
     out << "\nPlacement Result:\n";
     out << "  Grid: " << placementResult.gridCols << "x"
@@ -375,6 +477,50 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
           << "      Size: " << tile.width << "x" << tile.height << "\n";
     }
 
+    if (!placementScores.empty()) {
+      out << "\nAuto Placement Candidates:\n";
+      for (const auto &score : placementScores) {
+        out << "  " << score.name << ": score=" << score.score
+            << " utilization=" << score.utilization
+            << " minScale=" << score.minScale << " time=" << score.elapsedMs
+            << "ms" << (score.completed ? "" : " (over budget)") << "\n";
+      }
+    }
+
+    out << "\nPlacement Cache: " << g_placementCache.size() << " entries, "
+        << g_placementCache.hits() << " hits, " << g_placementCache.misses()
+        << " misses\n";
+
+    constexpr double MB = 1024.0 * 1024.0;
+    out << "\nVRAM budget: " << g_vramBudget.used() / MB << "MB used";
+    if (g_vramBudget.limit() > 0)
+      out << " of " << g_vramBudget.limit() / MB << "MB";
+    out << " (evictions " << g_vramBudget.evictions() << ", downscales "
+        << g_vramBudget.downscales() << ")\n";
+    for (auto &[monitor, instance] : g_pHyprViewInstances) {
+      if (instance && monitor)
+        out << "  " << monitor->m_name << ": "
+            << instance->vramUsage().total() / MB << "MB\n";
+    }
+    for (auto &[monitor, instance] : g_pHyprViewDormant) {
+      if (instance && monitor)
+        out << "  " << monitor->m_name << " (dormant): "
+            << instance->vramUsage().total() / MB << "MB\n";
+    }
+
+    out << "Dormant overviews: " << g_pHyprViewDormant.size() << "\n";
+    out << "Input router: "
+        << (g_inputRouter.installed() ? "installed" : "not installed") << "\n";
+    out << "Focus history: " << g_focusHistory.size() << " windows\n";
+    if (g_pSwitcher)
+      g_pSwitcher->writeDebugInfo(out);
+
+    out << "\nActive Overviews:\n";
+    for (auto &[monitor, instance] : g_pHyprViewInstances) {
+      if (instance)
+        instance->writeDebugInfo(out);
+    }
+
     out << "========== END DEBUG ==========\n\n";
     out.close();
 
@@ -392,6 +538,9 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
 
   // Handle OFF action
   if (parsedArgs.action == DispatcherArgs::Action::OFF) {
+    if (g_pSwitcher)
+      g_pSwitcher->cancel();
+
     // Close all instances, similar to onCursorSelect in hyprview.cpp
     for (auto &[monitor, instance] : g_pHyprViewInstances) {
       if (instance && !instance->closing) {
@@ -412,6 +561,7 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
     for (auto it = g_pHyprViewInstances.begin();
          it != g_pHyprViewInstances.end();) {
       if (it->second && it->second->closing) {
+        retireHyprView(it->first, std::move(it->second));
         it = g_pHyprViewInstances.erase(it);
       } else {
         ++it;
@@ -426,7 +576,8 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
     Debug::log(LOG, "[hyprview] 'on' command called with mode={}",
                (int)parsedArgs.collectionMode);
 
-    auto targetMonitors = getTargetMonitors(parsedArgs.targetMonitor);
+    auto targetMonitors = getTargetMonitors(parsedArgs.targetMonitor,
+                                            parsedArgs.collectionMode);
 
     if (targetMonitors.empty()) {
       return {.success = false, .error = "No matching monitor found"};
@@ -436,11 +587,13 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
     Debug::log(LOG, "[hyprview] Opening overview with mode={}",
                (int)parsedArgs.collectionMode);
     renderingOverview = true;
+    std::vector<PHLMONITOR> toOpen;
     for (auto &targetMonitor : targetMonitors) {
       if (targetMonitor->m_enabled && targetMonitor->m_activeWorkspace) {
-        // Check if already active on this monitor
+        // Check if already active on this monitor (a closing one is reopened)
         auto it = g_pHyprViewInstances.find(targetMonitor);
-        if (it != g_pHyprViewInstances.end() && it->second) {
+        if (it != g_pHyprViewInstances.end() && it->second &&
+            !it->second->closing) {
           Debug::log(
               LOG, "[hyprview] Overview already active on monitor {}, skipping",
               targetMonitor->m_description);
@@ -452,11 +605,11 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
                    "and placement={}",
                    targetMonitor->m_description, (int)parsedArgs.collectionMode,
                    parsedArgs.placement);
-        g_pHyprViewInstances[targetMonitor] = std::make_unique<CHyprView>(
-            targetMonitor, targetMonitor->m_activeWorkspace, false,
-            parsedArgs.collectionMode, parsedArgs.placement, true);
+        toOpen.push_back(targetMonitor);
       }
     }
+    openHyprViews(toOpen, parsedArgs.collectionMode, parsedArgs.placement,
+                  true);
     renderingOverview = false;
     return {};
   }
@@ -466,7 +619,8 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
     Debug::log(LOG, "[hyprview] Toggle called with mode={}",
                (int)parsedArgs.collectionMode);
 
-    auto targetMonitors = getTargetMonitors(parsedArgs.targetMonitor);
+    auto targetMonitors = getTargetMonitors(parsedArgs.targetMonitor,
+                                            parsedArgs.collectionMode);
 
     if (targetMonitors.empty()) {
       return {.success = false, .error = "No matching monitor found"};
@@ -478,7 +632,9 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
     bool hasOverviewOnTarget = false;
     for (auto &targetMonitor : targetMonitors) {
       auto it = g_pHyprViewInstances.find(targetMonitor);
-      if (it != g_pHyprViewInstances.end() && it->second) {
+      // One still animating its close is toggled back open below
+      if (it != g_pHyprViewInstances.end() && it->second &&
+          !it->second->closing) {
         // Count as toggleable if:
         // - Monitor was explicitly specified (can toggle even if stickyOn)
         // - OR instance is not explicitly on (general toggle affects it)
@@ -516,6 +672,7 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
       for (auto it = g_pHyprViewInstances.begin();
            it != g_pHyprViewInstances.end();) {
         if (it->second && it->second->readyForCleanup) {
+          retireHyprView(it->first, std::move(it->second));
           it = g_pHyprViewInstances.erase(it);
         } else {
           ++it;
@@ -530,11 +687,15 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
                  (int)parsedArgs.collectionMode);
 
       renderingOverview = true;
+      std::vector<PHLMONITOR> toOpen;
       for (auto &targetMonitor : targetMonitors) {
         if (targetMonitor->m_enabled && targetMonitor->m_activeWorkspace) {
           // Do not open if an instance already exists to avoid overwriting
-          // explicitly-on overviews
-          if (g_pHyprViewInstances.count(targetMonitor)) {
+          // explicitly-on overviews. A closing one is turned around by
+          // openHyprView().
+          auto it = g_pHyprViewInstances.find(targetMonitor);
+          if (it != g_pHyprViewInstances.end() && it->second &&
+              !it->second->closing) {
             Debug::log(LOG,
                        "[hyprview] Toggle: skipping monitor {} as it already "
                        "has an active overview",
@@ -546,11 +707,10 @@ static SDispatchResult onHyprviewDispatcher(std::string arg) {
                      "and placement={}",
                      targetMonitor->m_description,
                      (int)parsedArgs.collectionMode, parsedArgs.placement);
-          g_pHyprViewInstances[targetMonitor] = std::make_unique<CHyprView>(
-              targetMonitor, targetMonitor->m_activeWorkspace, false,
-              parsedArgs.collectionMode, parsedArgs.placement);
+          toOpen.push_back(targetMonitor);
         }
       }
+      openHyprViews(toOpen, parsedArgs.collectionMode, parsedArgs.placement);
       renderingOverview = false;
     }
 
@@ -566,6 +726,19 @@ static void failNotif(const std::string &reason) {
       CHyprColor{1.0, 0.2, 0.2, 1.0}, 5000);
 }
 
+static Hyprlang::CParseResult hyprviewRuleKeyword(const char *LHS,
+                                                  const char *RHS) {
+  Hyprlang::CParseResult result;
+
+  if (g_unloading)
+    return result;
+
+  if (auto error = addHyprViewRule(RHS))
+    result.setError(error->c_str());
+
+  return result;
+}
+
 static Hyprlang::CParseResult hyprviewGestureKeyword(const char *LHS,
                                                      const char *RHS) {
   Hyprlang::CParseResult result;
@@ -693,9 +866,24 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
   g_pAddDamageHookA = HyprlandAPI::createFunctionHook(PHANDLE, FNS[0].address,
                                                       (void *)hkAddDamageA);
 
+  // Overloads of other classes share the name, take the renderer's
+  FNS = HyprlandAPI::findFunctionsByName(PHANDLE, "damageSurface");
+  std::erase_if(FNS, [](const SFunctionMatch &match) {
+    return !match.demangled.contains("CHyprRenderer::damageSurface");
+  });
+  if (FNS.empty()) {
+    failNotif("no fns for hook CHyprRenderer::damageSurface");
+    throw std::runtime_error(
+        "[hyprview] No fns for hook CHyprRenderer::damageSurface");
+  }
+
+  g_pDamageSurfaceHook = HyprlandAPI::createFunctionHook(
+      PHANDLE, FNS[0].address, (void *)hkDamageSurface);
+
   bool success = g_pRenderWorkspaceHook->hook();
   success = success && g_pAddDamageHookA->hook();
   success = success && g_pAddDamageHookB->hook();
+  success = success && g_pDamageSurfaceHook->hook();
 
   if (!success) {
     failNotif("Failed initializing hooks");
@@ -710,6 +898,9 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
             instance->onPreRender();
         }
 
+        // Frames of all monitors count against one budget
+        g_vramBudget.enforce();
+
         // Clean up closing instances - but only when they're ready
         // This ensures the masking layer stays visible while windows are moved back
         for (auto it = g_pHyprViewInstances.begin();
@@ -718,11 +909,79 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
 
             g_pHyprRenderer->m_renderPass.removeAllOfType(
                 "CHyprViewPassElement");
+            retireHyprView(it->first, std::move(it->second));
             it = g_pHyprViewInstances.erase(it);
           } else {
             ++it;
           }
         }
+
+        // Input hooks only while something is open
+        g_inputRouter.update();
+
+        if (g_pSwitcher && g_pSwitcher->done) {
+          g_pHyprRenderer->m_renderPass.removeAllOfType("CSwitcherPassElement");
+          g_pSwitcher.reset();
+        } else if (g_pSwitcher) {
+          g_pSwitcher->onPreRender();
+        }
+      });
+
+  // The switcher strip is drawn over whatever the monitor shows
+  static auto renderHook = HyprlandAPI::registerCallbackDynamic(
+      PHANDLE, "render", [](void *self, SCallbackInfo &info, std::any param) {
+        if (g_pSwitcher &&
+            std::any_cast<eRenderStage>(param) == RENDER_LAST_MOMENT)
+          g_pSwitcher->render();
+      });
+
+  // Focus history for the switcher
+  static auto activeWindowHook = HyprlandAPI::registerCallbackDynamic(
+      PHANDLE, "activeWindow",
+      [](void *self, SCallbackInfo &info, std::any param) {
+        g_focusHistory.touch(std::any_cast<PHLWINDOW>(param));
+      });
+
+  static auto closeWindowHook = HyprlandAPI::registerCallbackDynamic(
+      PHANDLE, "closeWindow",
+      [](void *self, SCallbackInfo &info, std::any param) {
+        g_focusHistory.remove(std::any_cast<PHLWINDOW>(param));
+      });
+
+  g_focusHistory.touch(g_pCompositor->m_lastWindow.lock());
+
+  // Keeps the type-to-filter index in step with window titles
+  static auto windowTitleHook = HyprlandAPI::registerCallbackDynamic(
+      PHANDLE, "windowTitle",
+      [](void *self, SCallbackInfo &info, std::any param) {
+        const auto WINDOW = std::any_cast<PHLWINDOW>(param);
+        for (auto &[monitor, instance] : g_pHyprViewInstances) {
+          if (instance)
+            instance->onWindowTitleChanged(WINDOW);
+        }
+      });
+
+  // Rules are re-added by the keyword handler on every reload
+  static auto preConfigReloadHook = HyprlandAPI::registerCallbackDynamic(
+      PHANDLE, "preConfigReload",
+      [](void *self, SCallbackInfo &info, std::any param) {
+        g_hyprViewRules.clear();
+        // Dormant instances hold values of the old config
+        g_pHyprViewDormant.clear();
+      });
+
+  // A dormant instance would keep the monitor and its framebuffers alive
+  static auto monitorRemovedHook = HyprlandAPI::registerCallbackDynamic(
+      PHANDLE, "monitorRemoved",
+      [](void *self, SCallbackInfo &info, std::any param) {
+        g_pHyprViewDormant.erase(std::any_cast<PHLMONITOR>(param));
+      });
+
+  // Open instances keep their snapshot, the next open gets the new one
+  static auto configReloadedHook = HyprlandAPI::registerCallbackDynamic(
+      PHANDLE, "configReloaded",
+      [](void *self, SCallbackInfo &info, std::any param) {
+        reloadHyprViewConfig();
       });
 
   // Block workspace gestures when overview is active
@@ -797,6 +1056,8 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
 
   HyprlandAPI::addConfigKeyword(PHANDLE, "hyprview-gesture",
                                 ::hyprviewGestureKeyword, {});
+  HyprlandAPI::addConfigKeyword(PHANDLE, "hyprview-rule",
+                                ::hyprviewRuleKeyword, {});
 
   HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:margin",
                               Hyprlang::INT{10});
@@ -831,6 +1092,37 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
                               Hyprlang::FLOAT{0.85});
   HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:window_text_color",
                               Hyprlang::INT{0xFFFFFFFF});
+  HyprlandAPI::addConfigValue(PHANDLE,
+                              "plugin:hyprview:auto_placement_budget_ms",
+                              Hyprlang::INT{5});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:scroll_page_size",
+                              Hyprlang::INT{0});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:scroll_prefetch",
+                              Hyprlang::INT{200});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:group_workspaces",
+                              Hyprlang::INT{0});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:refresh_policy",
+                              Hyprlang::STRING{"live"});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:frame_budget_ms",
+                              Hyprlang::FLOAT{4.0});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:adaptive_quality",
+                              Hyprlang::INT{1});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:thumbnail_lod",
+                              Hyprlang::INT{1});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:hover_zoom",
+                              Hyprlang::FLOAT{1.0});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:thumbnail_atlas",
+                              Hyprlang::INT{0});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:thumbnail_profile",
+                              Hyprlang::STRING{"surface"});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:thumbnail_format",
+                              Hyprlang::STRING{"native"});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:vram_budget_mb",
+                              Hyprlang::INT{0});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:resident",
+                              Hyprlang::INT{0});
+  HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprview:switcher_count",
+                              Hyprlang::INT{8});
   HyprlandAPI::reloadConfig();
 
   return {"hyprview", "Window overview with multiple placement algorithms",
@@ -839,7 +1131,14 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
 
 APICALL EXPORT void PLUGIN_EXIT() {
   g_pHyprRenderer->m_renderPass.removeAllOfType("CHyprViewPassElement");
+  g_pHyprRenderer->m_renderPass.removeAllOfType("CSwitcherPassElement");
   g_unloading = true;
+  g_pSwitcher.reset();
+  g_focusHistory.clear();
+  g_pHyprViewDormant.clear();
   g_pHyprViewInstances.clear();
+  g_inputRouter.update();
+  g_placementCache.clear();
+  g_hyprViewRules.clear();
   g_pConfigManager->reload();
 }